@@ -0,0 +1,521 @@
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "../../common/alloc.hpp"
+#include "../../common/input.hpp"
+#include "../../common/json.hpp"
+#include "../../common/stats.hpp"
+#include "../days.hpp"
+
+/*
+    Advent of Code 2015 – benchmark harness
+
+    Usage:
+        aoc2015_bench <input-dir> [--reps N] [--warmup N] [--day N]...
+                      [--baseline FILE... [--threshold PCT] [--alpha P]]
+
+    Runs every selected day N times over `<input-dir>/dayNN.txt` and reports
+    min/median/p99 wall time for each phase as JSON on stdout:
+        - load:  opening and mapping the input file
+        - parse: turning the raw input into the day's data structures
+        - solve: computing both answers
+        - total: the sum of the three for each repetition
+    Every phase also lists its raw `samples_ns`, so a saved report can serve
+    as a baseline later.
+
+    Days without an input file in the directory are skipped with a note on
+    stderr, so a partial input set still produces a valid report.
+
+    Built with `-DAOC_ALLOC_TRACKING=ON`, each phase also reports the heap
+    allocations and bytes of one repetition, and the run exits with status 1
+    if any loop marked `AOC_ALLOCATION_FREE` allocated.
+
+    With `--baseline`, each phase is compared against the same day and phase
+    in a saved report. A phase regresses when a one-sided Mann-Whitney U test
+    says the new samples are larger (p < alpha, default 0.01) *and* all of:
+        - the effect is large: a new sample beats a baseline one with
+          probability at least 0.8, not merely a significant nudge
+        - the median grew by more than the threshold (default 10%) and by at
+          least 100 us
+        - the fastest sample grew by more than the threshold too; load on
+          the machine slows most repetitions but rarely the best one, so
+          a shifted median alone is not taken as a regression
+    so neither noise nor a statistically real but negligible change trips it.
+
+    A busy or throttled machine slows everything alike, which shifts whole
+    runs rather than single samples, and no test on the samples alone can
+    tell that from a regression. So before every repetition the harness also
+    times a fixed reference workload, and each day records the median as
+    `calibration_ns`. The baseline's samples are scaled by the ratio of the
+    two calibrations before they are compared. A slow stretch that the
+    calibration misses still passes every test above, so a day with any
+    regressed phase is measured a second time, and only phases that regress
+    in both measurements count.
+    The same code can also run a few percent faster or slower from one
+    process to the next, which no measurement inside one process can see.
+    `--baseline` may therefore be repeated: the reports' samples are pooled
+    per phase, each report's scaled to the calibration of the first, so the
+    baseline itself spans that spread, and a regression must also beat the
+    slowest report's median by the threshold.
+    Only phases whose baseline median is above that 100 us floor are gated:
+    below it, page faults and scheduler noise alone move the median by 20%
+    or more, so the comparison is printed but never fails the run. Any phase
+    can be large enough, e.g. day 2's parse dominates that day.
+    The comparison goes to stderr, and any regression makes the run exit
+    with status 1.
+
+    Both the baseline and the new run need at least 8 repetitions: the test's
+    normal approximation is poor below that, and under 5 per side it cannot
+    reach p < 0.01 at all. Fewer draws a warning.
+*/
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Samples {
+  std::vector<double> load;
+  std::vector<double> parse;
+  std::vector<double> solve;
+  std::vector<double> total;
+};
+
+// heap traffic of one repetition; the solutions are deterministic, so any
+// repetition will do
+struct Allocations {
+  aoc::alloc::Stats load;
+  aoc::alloc::Stats parse;
+  aoc::alloc::Stats solve;
+  aoc::alloc::Stats total;
+};
+
+// everything one day's repetitions produced
+struct Measurement {
+  Samples samples;
+  Allocations heap;
+  double calibration_ns;  // median time of the reference workload
+  std::string answer;
+};
+
+struct Recorded {
+  double calibration_ns;  // 0 in reports from before calibration
+  std::map<std::string, std::vector<double>> phases;  // samples in ns
+  std::map<std::string, double> slowest;  // highest median of any report
+};
+
+// day -> what the baseline recorded for it
+using Baseline = std::map<int, Recorded>;
+
+// a regression must also be at least this much slower in absolute terms
+constexpr double NOISE_FLOOR_NS{100'000.0};
+
+// smallest Vargha-Delaney A that counts as a regression ("large" is 0.71)
+constexpr double MIN_EFFECT{0.8};
+
+// fewer samples per side leave the regression test unreliable
+constexpr size_t MIN_GATED_REPS{8};
+
+// a dependent chain of integer operations plus a sweep over memory larger
+// than most L2 caches, about a millisecond each; returns its wall time in ns
+double reference_workload() {
+  static std::vector<uint64_t> memory(1 << 19, 1);
+  auto start{Clock::now()};
+
+  uint64_t x{0x9e3779b97f4a7c15};
+  for (int i{}; i < (1 << 20); ++i) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+  }
+  for (uint64_t& word : memory) {
+    word += x;
+    x = word * 3;
+  }
+
+  // keeps the work from being optimized away
+  asm volatile("" : : "r"(x) : "memory");
+  return std::chrono::duration<double, std::nano>(Clock::now() - start)
+      .count();
+}
+
+// runs `day` over the input at `path`, discarding the first `warmup`
+// repetitions
+Measurement measure(const aoc2015::Day& day, const std::filesystem::path& path,
+                    int repetitions, int warmup) {
+  Measurement result{};
+  std::vector<double> calibrations{};
+  Samples& samples{result.samples};
+  Allocations& heap{result.heap};
+
+  for (int rep{-warmup}; rep < repetitions; ++rep) {
+    calibrations.push_back(reference_workload());
+
+    aoc::alloc::Stats heap_at_start{aoc::alloc::current()};
+    auto start{Clock::now()};
+    const aoc::Input input{path.c_str()};
+    auto loaded_at{Clock::now()};
+    aoc::alloc::Stats heap_loaded_at{aoc::alloc::current()};
+
+    aoc2015::PhaseTimes times{};
+    result.answer = day.run(input.view(), times);
+
+    if (rep < 0) {
+      continue;
+    }
+
+    std::chrono::nanoseconds load{loaded_at - start};
+    samples.load.push_back(load.count());
+    samples.parse.push_back(times.parse.count());
+    samples.solve.push_back(times.solve.count());
+    samples.total.push_back((load + times.parse + times.solve).count());
+
+    heap.load = heap_loaded_at - heap_at_start;
+    heap.parse = times.parse_allocations;
+    heap.solve = times.solve_allocations;
+    heap.total = {
+        heap.load.allocations + heap.parse.allocations +
+            heap.solve.allocations,
+        heap.load.bytes + heap.parse.bytes + heap.solve.bytes};
+  }
+
+  result.calibration_ns = aoc::stats::summarize(calibrations).median;
+  return result;
+}
+
+bool parse_count(std::string_view sv, int& out) {
+  auto [ptr, ec]{std::from_chars(sv.data(), sv.data() + sv.size(), out)};
+  return ec == std::errc{} && ptr == sv.data() + sv.size() && out >= 0;
+}
+
+bool parse_fraction(std::string_view sv, double& out) {
+  auto [ptr, ec]{std::from_chars(sv.data(), sv.data() + sv.size(), out)};
+  return ec == std::errc{} && ptr == sv.data() + sv.size() && out >= 0.0;
+}
+
+// adds the report at `path` to `baseline`; a day recorded by several
+// reports pools their samples, each scaled to the calibration of the first
+void load_baseline(const char* path, Baseline& baseline) {
+  const aoc::Input input{path};
+  aoc::json::Value report{aoc::json::parse(input.view())};
+
+  for (const aoc::json::Value& day : report["days"].array) {
+    auto [entry, added]{
+        baseline.try_emplace(static_cast<int>(day["day"].number))};
+    Recorded& recorded{entry->second};
+    const aoc::json::Value* calibration{day.find("calibration_ns")};
+    double calibration_ns{calibration == nullptr ? 0.0 : calibration->number};
+    if (added) {
+      recorded.calibration_ns = calibration_ns;
+    }
+    double speed{recorded.calibration_ns > 0.0 && calibration_ns > 0.0
+                     ? recorded.calibration_ns / calibration_ns
+                     : 1.0};
+
+    for (const auto& [name, phase] : day["phases"].object) {
+      const aoc::json::Value* samples{phase.find("samples_ns")};
+      if (samples == nullptr) {
+        throw std::runtime_error(
+            "baseline has no raw samples; re-record it with this version");
+      }
+      std::vector<double> scaled{};
+      for (const aoc::json::Value& sample : samples->array) {
+        scaled.push_back(sample.number * speed);
+      }
+      double& slowest{recorded.slowest[name]};
+      slowest = std::max(slowest, aoc::stats::summarize(scaled).median);
+      std::ranges::copy(scaled, std::back_inserter(recorded.phases[name]));
+    }
+  }
+}
+
+// prints one line per phase and returns the names of those that regressed
+std::vector<std::string_view> compare(std::ostream& out,
+                                      const Baseline& baseline,
+                                      const aoc2015::Day& day,
+                                      const Measurement& run,
+                                      double threshold, double alpha) {
+  auto expected{baseline.find(day.number)};
+  if (expected == baseline.end()) {
+    out << day.name << ": not in the baseline\n";
+    return {};
+  }
+
+  const std::pair<std::string_view, const std::vector<double>*> phases[]{
+      {"load", &run.samples.load},
+      {"parse", &run.samples.parse},
+      {"solve", &run.samples.solve},
+      {"total", &run.samples.total}};
+  double calibration_ns{run.calibration_ns};
+
+  // how much slower the machine runs now than when the baseline was taken
+  const Recorded& recorded{expected->second};
+  double speed{recorded.calibration_ns > 0.0 && calibration_ns > 0.0
+                   ? calibration_ns / recorded.calibration_ns
+                   : 1.0};
+  out << day.name << ": baseline scaled by " << std::fixed
+      << std::setprecision(3) << speed << " for machine speed\n";
+
+  std::vector<std::string_view> regressions{};
+  for (const auto& [name, samples] : phases) {
+    auto found{recorded.phases.find(std::string(name))};
+    if (found == recorded.phases.end() || found->second.empty()) {
+      continue;
+    }
+    std::vector<double> before{found->second};
+    for (double& sample : before) {
+      sample *= speed;
+    }
+
+    aoc::stats::Summary old_summary{aoc::stats::summarize(before)};
+    aoc::stats::Summary new_summary{aoc::stats::summarize(*samples)};
+    double old_median{old_summary.median};
+    double slowest{recorded.slowest.at(found->first) * speed};
+    double new_median{new_summary.median};
+    double change{old_median > 0.0 ? new_median / old_median - 1.0 : 0.0};
+    double fastest_change{
+        old_summary.min > 0.0 ? new_summary.min / old_summary.min - 1.0 : 0.0};
+    auto [p, effect]{
+        aoc::stats::mann_whitney_greater(before, *samples)};
+
+    // too short to judge; see the header comment
+    bool gated{old_median > NOISE_FLOOR_NS};
+    bool regressed{gated && p < alpha && effect >= MIN_EFFECT &&
+                   change > threshold && fastest_change > threshold &&
+                   new_median - old_median >= NOISE_FLOOR_NS &&
+                   new_median > slowest * (1.0 + threshold)};
+    if (regressed) {
+      regressions.push_back(name);
+    }
+
+    out << day.name << ' ' << std::left << std::setw(6) << name << std::right
+        << std::fixed << std::setprecision(3) << old_median / 1e6 << " ms -> "
+        << new_median / 1e6 << " ms (" << std::showpos << std::setprecision(1)
+        << change * 100 << "% median, " << fastest_change * 100
+        << std::noshowpos << "% fastest, p=" << std::setprecision(4) << p
+        << ", A=" << std::setprecision(2) << effect << ')' << (regressed ? "  REGRESSION" : "")
+        << (gated ? "" : "  (not gated)") << '\n';
+  }
+  return regressions;
+}
+
+std::string json_escape(std::string_view sv) {
+  std::string result{};
+  result.reserve(sv.size());
+  for (char ch : sv) {
+    switch (ch) {
+      case '"':
+        result += "\\\"";
+        break;
+      case '\\':
+        result += "\\\\";
+        break;
+      case '\n':
+        result += "\\n";
+        break;
+      default:
+        result += ch;
+        break;
+    }
+  }
+  return result;
+}
+
+void print_phase(std::ostream& out, std::string_view name,
+                 const std::vector<double>& samples,
+                 const aoc::alloc::Stats& heap, bool last) {
+  aoc::stats::Summary summary{aoc::stats::summarize(samples)};
+  out << "        \"" << name
+      << "\": {\"min_ns\": " << static_cast<int64_t>(summary.min)
+      << ", \"median_ns\": " << static_cast<int64_t>(summary.median)
+      << ", \"p99_ns\": " << static_cast<int64_t>(summary.p99);
+  out << ", \"samples_ns\": [";
+  for (size_t i{}; i < samples.size(); ++i) {
+    out << (i == 0 ? "" : ", ") << static_cast<int64_t>(samples[i]);
+  }
+  out << ']';
+  if constexpr (aoc::alloc::ENABLED) {
+    out << ", \"allocations\": " << heap.allocations
+        << ", \"bytes\": " << heap.bytes;
+  }
+  out << '}' << (last ? "\n" : ",\n");
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    std::cerr << "usage: aoc2015_bench <input-dir> [--reps N] [--warmup N] "
+                 "[--day N]... [--baseline FILE... [--threshold PCT] "
+                 "[--alpha P]]\n";
+    return -1;
+  }
+
+#ifdef __GLIBC__
+  // glibc hands large freed blocks back to the kernel, so whether a phase
+  // pays for page faults on every repetition depends on what ran before it
+  // in the same process; keeping freed memory mapped makes a day's timings
+  // independent of which other days were selected
+  mallopt(M_MMAP_THRESHOLD, 1 << 30);
+  mallopt(M_TRIM_THRESHOLD, -1);
+#endif
+
+  const std::filesystem::path input_dir{argv[1]};
+  int repetitions{10};
+  int warmup{1};
+  std::vector<int> selected{};
+  std::vector<const char*> baseline_paths{};
+  double threshold{10.0};
+  double alpha{0.01};
+
+  for (int i{2}; i < argc; ++i) {
+    std::string_view arg{argv[i]};
+    if (i + 1 >= argc) {
+      std::cerr << "missing value for " << arg << '\n';
+      return -1;
+    }
+    std::string_view value{argv[++i]};
+
+    int count{};
+    bool ok{true};
+    if (arg == "--reps") {
+      ok = parse_count(value, count);
+      repetitions = std::max(count, 1);
+    } else if (arg == "--warmup") {
+      ok = parse_count(value, warmup);
+    } else if (arg == "--day") {
+      ok = parse_count(value, count);
+      selected.push_back(count);
+    } else if (arg == "--baseline") {
+      baseline_paths.push_back(value.data());
+    } else if (arg == "--threshold") {
+      ok = parse_fraction(value, threshold);
+    } else if (arg == "--alpha") {
+      ok = parse_fraction(value, alpha) && alpha <= 1.0;
+    } else {
+      std::cerr << "unknown option " << arg << '\n';
+      return -1;
+    }
+
+    if (!ok) {
+      std::cerr << "invalid value for " << arg << ": " << value << '\n';
+      return -1;
+    }
+  }
+
+  Baseline baseline{};
+  if (!baseline_paths.empty()) {
+    for (const char* path : baseline_paths) {
+      try {
+        load_baseline(path, baseline);
+      } catch (const std::exception& e) {
+        std::cerr << "could not read baseline " << path << ": " << e.what()
+                  << '\n';
+        return -1;
+      }
+    }
+
+    size_t baseline_reps{SIZE_MAX};
+    for (const auto& [number, recorded] : baseline) {
+      for (const auto& [name, samples] : recorded.phases) {
+        baseline_reps = std::min(baseline_reps, samples.size());
+      }
+    }
+    if (std::min(baseline_reps, static_cast<size_t>(repetitions)) <
+        MIN_GATED_REPS) {
+      std::cerr << "warning: the regression test needs at least "
+                << MIN_GATED_REPS << " repetitions in both the baseline and "
+                << "this run; results will be unreliable\n";
+    }
+  }
+  int regressions{};
+
+  std::cout << "{\n  \"year\": 2015,\n  \"repetitions\": " << repetitions
+            << ",\n  \"days\": [";
+
+  bool first{true};
+  for (const aoc2015::Day& day : aoc2015::all_days()) {
+    if (!selected.empty() && std::ranges::find(selected, day.number) ==
+                                 selected.end()) {
+      continue;
+    }
+
+    std::filesystem::path path{input_dir / (std::string(day.name) + ".txt")};
+    if (!std::filesystem::exists(path)) {
+      std::cerr << "skipping " << day.name << ": no input at " << path << '\n';
+      continue;
+    }
+
+    Measurement run{measure(day, path, repetitions, warmup)};
+
+    std::cout << (first ? "\n" : ",\n");
+    first = false;
+
+    std::cout << "    {\n      \"day\": " << day.number << ",\n"
+              << "      \"answer\": \"" << json_escape(run.answer) << "\",\n"
+              << "      \"calibration_ns\": "
+              << static_cast<int64_t>(run.calibration_ns) << ",\n"
+              << "      \"phases\": {\n";
+    print_phase(std::cout, "load", run.samples.load, run.heap.load,
+                false);
+    print_phase(std::cout, "parse", run.samples.parse, run.heap.parse,
+                false);
+    print_phase(std::cout, "solve", run.samples.solve, run.heap.solve,
+                false);
+    print_phase(std::cout, "total", run.samples.total, run.heap.total,
+                true);
+    std::cout << "      }\n    }";
+
+    if (baseline_paths.empty()) {
+      continue;
+    }
+    std::vector<std::string_view> flagged{
+        compare(std::cerr, baseline, day, run, threshold / 100.0, alpha)};
+    if (flagged.empty()) {
+      continue;
+    }
+
+    // a slow stretch on the machine passes every test above, but it rarely
+    // lasts through a second measurement; a real regression does
+    std::cerr << day.name << ": re-measuring to confirm\n";
+    Measurement again{measure(day, path, repetitions, warmup)};
+    std::vector<std::string_view> confirmed{
+        compare(std::cerr, baseline, day, again, threshold / 100.0, alpha)};
+    for (std::string_view name : flagged) {
+      regressions += std::ranges::find(confirmed, name) != confirmed.end();
+    }
+  }
+
+  std::cout << "\n  ]\n}\n";
+
+  // report every kind of failure before exiting
+  bool failed{false};
+  if (regressions > 0) {
+    std::cerr << regressions << " phase(s) regressed against the baseline\n";
+    failed = true;
+  }
+
+  if (uint64_t violations{aoc::alloc::violations()}; violations > 0) {
+    std::cerr << violations << " allocation(s) inside allocation-free loops, "
+              << "first in " << aoc::alloc::first_violation() << '\n';
+    failed = true;
+  }
+
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,454 @@
+#include "day01.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#ifdef __x86_64__
+#include <immintrin.h>
+#define AOC_DAY01_X86 1
+#endif
+
+#include "../../common/alloc.hpp"
+#include "../../common/metrics.hpp"
+#include "../../common/thread_pool.hpp"
+
+/*
+    Advent of Code 2015 – Day 1
+
+    Problem:
+        Interpret '(' as up and ')' as down to track Santa's floor
+        Determine the 1-indexed position of the first character that places
+   Santa in the basement (floor -1)
+
+    Approach:
+        Map input file into a `std::string_view`
+        Count '(' and ')' with a SIMD kernel picked at startup from the CPU's
+   features: AVX2 (32 bytes per step), SSE2 (16 bytes) or a scalar loop.
+   Per-byte comparison masks are accumulated in 8-bit lanes and widened with
+   `psadbw` every 255 steps.
+        Until the basement is found, walk the directions in 64-byte blocks.
+   The same kernel family turns a block into +1/-1 steps and takes their
+   in-register prefix sums (log-step byte shifts), giving the block's net
+   change and its exact lowest running floor. A block is skipped unless the
+   floor before it plus that minimum goes negative, so only the one block
+   that really crosses into the basement is walked byte by byte. Once found,
+   the rest is one vector count.
+        With `--stream`, the directions are fed chunk by chunk through
+   `accumulate` so the input never has to fit in memory
+        With `--threads N`, the buffer is split into pieces that are
+   summarized in parallel with the same block kernel as (net delta, exact
+   lowest floor). Folding the summaries in order gives the floor before
+   every piece; only the first piece whose lowest floor takes that to -1 is
+   run again through `accumulate` to place the step exactly, and the rest
+   only add their deltas
+
+    Complexity:
+        O(n) time, O(n / p) span with p threads
+        O(1) space, O(p) with threads
+ */
+
+namespace aoc2015::day01 {
+
+namespace {
+
+struct Counts {
+  size_t opens;
+  size_t closes;
+};
+
+using CountFn = Counts (*)(const char* data, size_t size);
+
+// what a run of directions does to the floor, relative to the floor before it
+struct Prefix {
+  int64_t delta;
+  int64_t lowest;  // lowest floor reached after any of its steps
+};
+
+// summarizes exactly BLOCK_SIZE bytes
+using PrefixFn = Prefix (*)(const char* data);
+
+// large enough to amortize a kernel call, small enough that walking the one
+// block that crosses into the basement is cheap
+constexpr size_t BLOCK_SIZE{64};
+
+// smaller pieces are not worth handing to another thread
+constexpr size_t MIN_PIECE_SIZE{1 << 20};
+
+
+Prefix prefix_scalar(const char* data, size_t size) {
+  Prefix prefix{0, INT64_MAX};
+  for (size_t i{}; i < size; ++i) {
+    prefix.delta += (data[i] == '(') - (data[i] == ')');
+    prefix.lowest = std::min(prefix.lowest, prefix.delta);
+  }
+  return prefix;
+}
+
+Prefix prefix_block_scalar(const char* data) {
+  return prefix_scalar(data, BLOCK_SIZE);
+}
+
+Counts count_scalar(const char* data, size_t size) {
+  Counts counts{};
+  for (size_t i{}; i < size; ++i) {
+    counts.opens += data[i] == '(';
+    counts.closes += data[i] == ')';
+  }
+  return counts;
+}
+
+#ifdef AOC_DAY01_X86
+
+// SSE2 is part of the x86-64 baseline, so this needs no target attribute
+Counts count_sse2(const char* data, size_t size) {
+  const __m128i open{_mm_set1_epi8('(')};
+  const __m128i close{_mm_set1_epi8(')')};
+  const __m128i zero{_mm_setzero_si128()};
+
+  __m128i opens{zero};
+  __m128i closes{zero};
+  size_t i{};
+  while (size - i >= 16) {
+    // 8-bit lane counters overflow after 255 steps
+    __m128i lane_opens{zero};
+    __m128i lane_closes{zero};
+    for (int step{}; step < 255 && size - i >= 16; ++step, i += 16) {
+      __m128i bytes{
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i))};
+      lane_opens = _mm_sub_epi8(lane_opens, _mm_cmpeq_epi8(bytes, open));
+      lane_closes = _mm_sub_epi8(lane_closes, _mm_cmpeq_epi8(bytes, close));
+    }
+    opens = _mm_add_epi64(opens, _mm_sad_epu8(lane_opens, zero));
+    closes = _mm_add_epi64(closes, _mm_sad_epu8(lane_closes, zero));
+  }
+
+  opens = _mm_add_epi64(opens, _mm_unpackhi_epi64(opens, opens));
+  closes = _mm_add_epi64(closes, _mm_unpackhi_epi64(closes, closes));
+
+  Counts counts{count_scalar(data + i, size - i)};
+  counts.opens += static_cast<size_t>(_mm_cvtsi128_si64(opens));
+  counts.closes += static_cast<size_t>(_mm_cvtsi128_si64(closes));
+  return counts;
+}
+
+// +1 for '(' and -1 for ')', one byte lane per direction
+__m128i steps_sse2(const char* data) {
+  __m128i bytes{_mm_loadu_si128(reinterpret_cast<const __m128i*>(data))};
+  return _mm_sub_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(')')),
+                      _mm_cmpeq_epi8(bytes, _mm_set1_epi8('(')));
+}
+
+// every running floor inside a block lies in [-64, 64], so 8-bit lanes hold
+// them; SSE2 only has an unsigned byte minimum, hence the bias
+Prefix prefix_sse2(const char* data) {
+  const __m128i bias{_mm_set1_epi8(static_cast<char>(0x80))};
+
+  __m128i running{_mm_setzero_si128()};
+  __m128i lowest{_mm_set1_epi8(static_cast<char>(0xff))};
+  for (size_t i{}; i < BLOCK_SIZE; i += 16) {
+    __m128i floors{steps_sse2(data + i)};
+    floors = _mm_add_epi8(floors, _mm_slli_si128(floors, 1));
+    floors = _mm_add_epi8(floors, _mm_slli_si128(floors, 2));
+    floors = _mm_add_epi8(floors, _mm_slli_si128(floors, 4));
+    floors = _mm_add_epi8(floors, _mm_slli_si128(floors, 8));
+    floors = _mm_add_epi8(floors, running);
+    lowest = _mm_min_epu8(lowest, _mm_xor_si128(floors, bias));
+
+    // broadcast the last lane to carry the floor into the next 16 bytes
+    __m128i last{_mm_shufflehi_epi16(_mm_unpackhi_epi8(floors, floors), 0xff)};
+    running = _mm_unpackhi_epi64(last, last);
+  }
+
+  lowest = _mm_min_epu8(lowest, _mm_srli_si128(lowest, 8));
+  lowest = _mm_min_epu8(lowest, _mm_srli_si128(lowest, 4));
+  lowest = _mm_min_epu8(lowest, _mm_srli_si128(lowest, 2));
+  lowest = _mm_min_epu8(lowest, _mm_srli_si128(lowest, 1));
+
+  return Prefix{
+      static_cast<int8_t>(_mm_cvtsi128_si32(running)),
+      static_cast<int8_t>((_mm_cvtsi128_si32(lowest) & 0xff) ^ 0x80)};
+}
+
+__attribute__((target("avx2"))) Prefix prefix_avx2(const char* data) {
+  const __m256i open{_mm256_set1_epi8('(')};
+  const __m256i close{_mm256_set1_epi8(')')};
+  const __m256i last_lane{_mm256_set1_epi8(15)};
+
+  __m256i running{_mm256_setzero_si256()};
+  __m256i lowest{_mm256_set1_epi8(INT8_MAX)};
+  for (size_t i{}; i < BLOCK_SIZE; i += 32) {
+    __m256i bytes{
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i))};
+    __m256i floors{_mm256_sub_epi8(_mm256_cmpeq_epi8(bytes, close),
+                                   _mm256_cmpeq_epi8(bytes, open))};
+    // byte shifts stay within each 128-bit half...
+    floors = _mm256_add_epi8(floors, _mm256_slli_si256(floors, 1));
+    floors = _mm256_add_epi8(floors, _mm256_slli_si256(floors, 2));
+    floors = _mm256_add_epi8(floors, _mm256_slli_si256(floors, 4));
+    floors = _mm256_add_epi8(floors, _mm256_slli_si256(floors, 8));
+    // ...so the low half's total is carried into the high half separately
+    __m256i totals{_mm256_shuffle_epi8(floors, last_lane)};
+    floors = _mm256_add_epi8(floors,
+                             _mm256_permute2x128_si256(totals, totals, 0x08));
+    floors = _mm256_add_epi8(floors, running);
+    lowest = _mm256_min_epi8(lowest, floors);
+
+    totals = _mm256_shuffle_epi8(floors, last_lane);
+    running = _mm256_permute2x128_si256(totals, totals, 0x11);
+  }
+
+  __m128i low{_mm_min_epi8(_mm256_castsi256_si128(lowest),
+                           _mm256_extracti128_si256(lowest, 1))};
+  low = _mm_min_epi8(low, _mm_srli_si128(low, 8));
+  low = _mm_min_epi8(low, _mm_srli_si128(low, 4));
+  low = _mm_min_epi8(low, _mm_srli_si128(low, 2));
+  low = _mm_min_epi8(low, _mm_srli_si128(low, 1));
+
+  Prefix prefix{static_cast<int8_t>(_mm256_extract_epi8(running, 0)),
+                static_cast<int8_t>(_mm_cvtsi128_si32(low))};
+  _mm256_zeroupper();
+  return prefix;
+}
+
+__attribute__((target("avx2"))) Counts count_avx2(const char* data,
+                                                  size_t size) {
+  const __m256i open{_mm256_set1_epi8('(')};
+  const __m256i close{_mm256_set1_epi8(')')};
+  const __m256i zero{_mm256_setzero_si256()};
+
+  __m256i opens{zero};
+  __m256i closes{zero};
+  size_t i{};
+  while (size - i >= 32) {
+    __m256i lane_opens{zero};
+    __m256i lane_closes{zero};
+    for (int step{}; step < 255 && size - i >= 32; ++step, i += 32) {
+      __m256i bytes{
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i))};
+      lane_opens = _mm256_sub_epi8(lane_opens, _mm256_cmpeq_epi8(bytes, open));
+      lane_closes =
+          _mm256_sub_epi8(lane_closes, _mm256_cmpeq_epi8(bytes, close));
+    }
+    opens = _mm256_add_epi64(opens, _mm256_sad_epu8(lane_opens, zero));
+    closes = _mm256_add_epi64(closes, _mm256_sad_epu8(lane_closes, zero));
+  }
+
+  size_t total_opens{static_cast<size_t>(
+      _mm256_extract_epi64(opens, 0) + _mm256_extract_epi64(opens, 1) +
+      _mm256_extract_epi64(opens, 2) + _mm256_extract_epi64(opens, 3))};
+  size_t total_closes{static_cast<size_t>(
+      _mm256_extract_epi64(closes, 0) + _mm256_extract_epi64(closes, 1) +
+      _mm256_extract_epi64(closes, 2) + _mm256_extract_epi64(closes, 3))};
+
+  // the tail runs legacy-encoded SSE code, which stalls while the upper
+  // halves of the ymm registers are dirty
+  _mm256_zeroupper();
+  Counts counts{count_sse2(data + i, size - i)};
+  counts.opens += total_opens;
+  counts.closes += total_closes;
+  return counts;
+}
+
+#endif
+
+bool supported(Kernel kernel) {
+  switch (kernel) {
+    case Kernel::SCALAR:
+      return true;
+#ifdef AOC_DAY01_X86
+    case Kernel::SSE2:
+      return true;
+    case Kernel::AVX2:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2");
+#endif
+    default:
+      return false;
+  }
+}
+
+CountFn kernel_function(Kernel kernel) {
+  switch (kernel) {
+#ifdef AOC_DAY01_X86
+    case Kernel::SSE2:
+      return count_sse2;
+    case Kernel::AVX2:
+      return count_avx2;
+#endif
+    default:
+      return count_scalar;
+  }
+}
+
+PrefixFn prefix_function(Kernel kernel) {
+  switch (kernel) {
+#ifdef AOC_DAY01_X86
+    case Kernel::SSE2:
+      return prefix_sse2;
+    case Kernel::AVX2:
+      return prefix_avx2;
+#endif
+    default:
+      return prefix_block_scalar;
+  }
+}
+
+CountFn count_parens{kernel_function(best_kernel())};
+PrefixFn prefix_block{prefix_function(best_kernel())};
+
+// walks directions one by one until the floor first reaches -1 and returns
+// how many it consumed
+size_t walk(Answer& answer, size_t offset, std::string_view directions) {
+  for (size_t i{}; i < directions.size(); ++i) {
+    answer.floor += (directions[i] == '(') - (directions[i] == ')');
+    if (answer.floor == -1) {
+      answer.basement = offset + i + 1;
+      return i + 1;
+    }
+  }
+  return directions.size();
+}
+
+// what a whole piece does to the floor; `lowest` is at most 0
+Prefix summarize(std::string_view piece) {
+  Prefix summary{0, 0};
+  for (size_t pos{}; pos < piece.size(); pos += BLOCK_SIZE) {
+    size_t size{std::min(BLOCK_SIZE, piece.size() - pos)};
+    Prefix block{size == BLOCK_SIZE ? prefix_block(piece.data() + pos)
+                                    : prefix_scalar(piece.data() + pos, size)};
+    summary.lowest = std::min(summary.lowest, summary.delta + block.lowest);
+    summary.delta += block.delta;
+  }
+  return summary;
+}
+
+}  // namespace
+
+Kernel best_kernel() {
+  for (Kernel kernel : {Kernel::AVX2, Kernel::SSE2}) {
+    if (supported(kernel)) {
+      return kernel;
+    }
+  }
+  return Kernel::SCALAR;
+}
+
+void use_kernel(Kernel kernel) {
+  if (!supported(kernel)) {
+    throw std::runtime_error("kernel not supported on this CPU");
+  }
+  count_parens = kernel_function(kernel);
+  prefix_block = prefix_function(kernel);
+}
+
+std::string_view kernel_name(Kernel kernel) {
+  switch (kernel) {
+    case Kernel::AVX2:
+      return "avx2";
+    case Kernel::SSE2:
+      return "sse2";
+    default:
+      return "scalar";
+  }
+}
+
+std::string_view parse(std::string_view buffer) { return buffer; }
+
+Answer solve(std::string_view directions) {
+  Answer answer{};
+  accumulate(answer, 0, directions);
+  return answer;
+}
+
+Answer solve_parallel(std::string_view directions, size_t threads) {
+  // capped before scaling, so no thread count can overflow
+  size_t most{directions.size() / MIN_PIECE_SIZE};
+  size_t pieces{std::min(std::min(threads, most) * 4, most)};
+  if (threads <= 1 || pieces <= 1) {
+    return solve(directions);
+  }
+
+  // whole kernel blocks per piece keep the vector loops aligned
+  size_t piece_size{(directions.size() / pieces + BLOCK_SIZE - 1) /
+                    BLOCK_SIZE * BLOCK_SIZE};
+  std::vector<std::string_view> views{};
+  for (size_t pos{}; pos < directions.size(); pos += piece_size) {
+    views.push_back(directions.substr(pos, piece_size));
+  }
+
+  std::vector<Prefix> summaries(views.size());
+  {
+    aoc::ThreadPool pool{threads};
+    for (size_t i{}; i < views.size(); ++i) {
+      pool.submit([&views, &summaries, i] {
+        summaries[i] = summarize(views[i]);
+      });
+    }
+    pool.wait();
+  }
+
+  Answer answer{};
+  for (size_t i{}; i < views.size(); ++i) {
+    const Prefix& summary{summaries[i]};
+    // the lowest floor is exact, so this is the one piece that crosses;
+    // `accumulate` skips its blocks up to the crossing one
+    if (!answer.basement.has_value() && answer.floor + summary.lowest < 0) {
+      AOC_COUNT("day01.pieces.rescanned", 1);
+      Answer crossing{answer.floor, std::nullopt};
+      accumulate(crossing, i * piece_size, views[i]);
+      answer.basement = crossing.basement;
+    }
+    answer.floor += summary.delta;
+  }
+  return answer;
+}
+
+void accumulate(Answer& answer, size_t offset, std::string_view chunk) {
+  auto& [floor, basement_tracking] = answer;
+
+  AOC_ALLOCATION_FREE("day01.accumulate");
+
+  size_t pos{};
+  while (!basement_tracking.has_value() && chunk.size() - pos >= BLOCK_SIZE) {
+    Prefix block{prefix_block(chunk.data() + pos)};
+
+    if (floor + block.lowest >= 0) {
+      AOC_COUNT("day01.blocks.skipped", 1);
+      floor += block.delta;
+      pos += BLOCK_SIZE;
+      continue;
+    }
+
+    // the lowest floor is exact, so this block does cross
+    AOC_COUNT("day01.blocks.walked", 1);
+    pos += walk(answer, offset + pos, chunk.substr(pos, BLOCK_SIZE));
+  }
+
+  if (!basement_tracking.has_value()) {
+    // a tail shorter than a block
+    pos += walk(answer, offset + pos, chunk.substr(pos));
+  }
+
+  Counts counts{count_parens(chunk.data() + pos, chunk.size() - pos)};
+  floor +=
+      static_cast<int64_t>(counts.opens) - static_cast<int64_t>(counts.closes);
+}
+
+void print(std::ostream& out, const Answer& answer) {
+  out << "Floor: " << answer.floor << '\n';
+
+  if (answer.basement.has_value()) {
+    out << "First character that directs to basement: "
+        << answer.basement.value() << '\n';
+  } else {
+    out << "never made it to the basement\n";
+  }
+}
+
+}  // namespace aoc2015::day01
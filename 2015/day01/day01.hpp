@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string_view>
+
+namespace aoc2015::day01 {
+
+struct Answer {
+  int64_t floor;
+  std::optional<size_t> basement;
+};
+
+// counting kernels; the best one the CPU supports is picked at startup
+enum class Kernel { SCALAR, SSE2, AVX2 };
+
+Kernel best_kernel();
+// switches kernels, e.g. to compare them; throws if the CPU lacks it
+void use_kernel(Kernel kernel);
+std::string_view kernel_name(Kernel kernel);
+
+std::string_view parse(std::string_view buffer);
+Answer solve(std::string_view directions);
+
+// `solve` with the buffer split across `threads` workers
+Answer solve_parallel(std::string_view directions, size_t threads);
+
+// streaming form of `solve`: folds the next chunk of directions into
+// `answer`, where `offset` is the number of characters before the chunk
+void accumulate(Answer& answer, size_t offset, std::string_view chunk);
+void print(std::ostream& out, const Answer& answer);
+
+}  // namespace aoc2015::day01
@@ -1,26 +1,17 @@
-#include <fstream>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <exception>
 #include <iostream>
 #include <optional>
 #include <stdexcept>
-#include <string>
+#include <string_view>
 
-/*
-    Advent of Code 2015 – Day 1
-
-    Problem:
-        Interpret '(' as up and ')' as down to track Santa's floor
-        Determine the 1-indexed position of the first character that places
-   Santa in the basement (floor -1)
-
-    Approach:
-        Read input file into string buffer, and read character by character
-        Use `std::optional<size_t>` to track Santa's first trip to the basement
-   and store the character's position
-
-    Complexity:
-        O(n) time
-        O(1) space
- */
+#include "../../common/args.hpp"
+#include "../../common/input.hpp"
+#include "../../common/metrics.hpp"
+#include "../../common/stream.hpp"
+#include "day01.hpp"
 
 int main(int argc, char* argv[]) {
   if (argc < 2) {
@@ -28,40 +19,53 @@ int main(int argc, char* argv[]) {
     return -1;
   }
 
-  std::ifstream file{argv[1], std::ios::ate};
-  if (!file.is_open()) {
-    throw std::runtime_error("could not open input file");
-  }
-
-  std::string buffer(file.tellg(), '\0');
-  file.seekg(0);
-  file.read(buffer.data(), buffer.size());
+  namespace day = aoc2015::day01;
 
-  int floor{};
-  std::optional<size_t> basement_tracking{};
-
-  for (size_t i{}; i < buffer.size(); ++i) {
-    const char& ch{buffer[i]};
-
-    if (ch == '(') {
-      ++floor;
-    } else if (ch == ')') {
-      --floor;
+  if (const char* name{aoc::option_value(argc, argv, "--kernel")}) {
+    constexpr std::array KERNELS{day::Kernel::SCALAR, day::Kernel::SSE2,
+                                 day::Kernel::AVX2};
+    auto kernel{std::ranges::find_if(KERNELS, [name](day::Kernel k) {
+      return day::kernel_name(k) == name;
+    })};
+    try {
+      if (kernel == KERNELS.end()) {
+        throw std::runtime_error("unknown kernel (scalar, sse2 or avx2)");
+      }
+      day::use_kernel(*kernel);
+    } catch (const std::exception& e) {
+      std::cerr << name << ": " << e.what() << '\n';
+      return -1;
     }
+  }
 
-    if (floor == -1 && !basement_tracking.has_value()) {
-      basement_tracking = i + 1;
+  std::optional<size_t> threads{};
+  if (const char* value{aoc::option_value(argc, argv, "--threads")}) {
+    threads = aoc::positive_count(value);
+    if (!threads.has_value()) {
+      std::cerr << value << ": --threads needs a count of at least 1\n";
+      return -1;
     }
   }
 
-  std::cout << "Floor: " << floor << '\n';
-  
-  if (basement_tracking.has_value()) {
-    std::cout << "First character that directs to basement: "
-              << basement_tracking.value() << '\n';
+  day::Answer answer{};
+  if (aoc::has_flag(argc, argv, "--stream")) {
+    size_t offset{};
+    aoc::for_each_chunk(argv[1], [&](std::string_view chunk) {
+      day::accumulate(answer, offset, chunk);
+      offset += chunk.size();
+    });
+  } else if (threads.has_value()) {
+    const aoc::Input input{argv[1]};
+    answer = day::solve_parallel(day::parse(input.view()), *threads);
   } else {
-    std::cout << "never made it to the basement\n";
+    const aoc::Input input{argv[1]};
+    answer = day::solve(day::parse(input.view()));
+  }
+  day::print(std::cout, answer);
+
+  if (aoc::metrics::stats_requested(argc, argv)) {
+    aoc::metrics::report(std::cerr);
   }
 
   return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,323 @@
+#include "day02.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#ifdef __x86_64__
+#include <immintrin.h>
+#define AOC_DAY02_X86 1
+#endif
+
+#include "../../common/alloc.hpp"
+#include "../../common/thread_pool.hpp"
+
+/*
+    Advent of Code 2015 – Day 2
+
+  Problem:
+        Calculate wrapping paper and ribbon needed for presents
+
+    Approach:
+        Map input file into a `std::string_view` and parse every `LxWxH` line
+  with a hand-rolled digit loop into three column arrays (length, width,
+  height)
+
+        For each box, order the sides with a three-comparator min/max sorting
+  network instead of `std::sort`, then
+        - wrapping paper = 2*ab + 2*bc + 2*ca + ab (smallest side area)
+        - ribbon         = abc + 2*(a + b)        (smallest perimeter)
+  where a <= b <= c. With AVX2 (picked at runtime) eight boxes go through the
+  network at once and the totals are widened into 64-bit lanes; otherwise a
+  scalar loop does the same per box.
+
+        Sides are limited to 65535, so every pairwise product fits in an
+  unsigned 32-bit lane, while abc (up to 48 bits) is multiplied straight into
+  64-bit lanes. The vector lanes are folded into the totals often enough that
+  they never wrap, and every add to a 64-bit total is checked: an input big
+  enough to overflow one (about 2^15 maximal boxes for the ribbon) throws
+  instead of printing a wrapped answer
+
+        With `--threads N`, the buffer is cut at line boundaries and each
+  chunk is parsed and reduced on its own thread
+
+        With `--stream`, each line is parsed and accumulated as it is read
+
+    Complexity:
+        O(n) time - constant time per line
+        O(n) space - three sides per line, O(1) when streaming
+ */
+
+namespace aoc2015::day02 {
+
+namespace {
+
+constexpr uint32_t MAX_SIDE{65535};
+
+// vector steps between folds into the totals: a step adds under 2^50 to a
+// 64-bit lane, so 2^13 of them stay clear of 2^63
+constexpr size_t FOLD_STEPS{1 << 13};
+
+// smaller chunks are not worth handing to another thread
+constexpr size_t MIN_CHUNK_SIZE{1 << 20};
+
+// reads one side up to (not including) the next non-digit
+uint32_t read_side(std::string_view line, size_t& pos) {
+  size_t start{pos};
+  uint32_t value{};
+  while (pos < line.size() && line[pos] >= '0' && line[pos] <= '9') {
+    value = value * 10 + static_cast<uint32_t>(line[pos] - '0');
+    if (value > MAX_SIDE) {
+      throw std::runtime_error("box side out of range\n");
+    }
+    ++pos;
+  }
+  if (pos == start) {
+    throw std::runtime_error("invalid line format\n");
+  }
+  return value;
+}
+
+void expect(std::string_view line, size_t& pos, char separator) {
+  if (pos == line.size() || line[pos] != separator) {
+    throw std::runtime_error("expected 3 dimensions per line\n");
+  }
+  ++pos;
+}
+
+// totals throw rather than wrap
+void add(int64_t& total, int64_t amount) {
+  if (__builtin_add_overflow(total, amount, &total)) {
+    throw std::overflow_error("box totals overflow 64 bits\n");
+  }
+}
+
+void sort_sides(uint32_t& a, uint32_t& b, uint32_t& c) {
+  uint32_t low{std::min(a, b)};
+  uint32_t high{std::max(a, b)};
+  uint32_t middle{std::min(high, c)};
+  c = std::max(high, c);
+  a = std::min(low, middle);
+  b = std::max(low, middle);
+}
+
+void parse_into(Boxes& boxes, std::string_view buffer) {
+  // the shortest line, "1x1x1\n", is six bytes
+  size_t estimate{buffer.size() / 6 + 1};
+  boxes.length.reserve(estimate);
+  boxes.width.reserve(estimate);
+  boxes.height.reserve(estimate);
+
+  // one pass over the buffer: side 'x' side 'x' side, then '\n' or the end
+  size_t pos{};
+  while (pos < buffer.size()) {
+    uint32_t length{read_side(buffer, pos)};
+    expect(buffer, pos, 'x');
+    uint32_t width{read_side(buffer, pos)};
+    expect(buffer, pos, 'x');
+    uint32_t height{read_side(buffer, pos)};
+    if (pos < buffer.size()) {
+      expect(buffer, pos, '\n');
+    }
+
+    boxes.length.push_back(length);
+    boxes.width.push_back(width);
+    boxes.height.push_back(height);
+  }
+}
+
+Answer reduce_scalar(const uint32_t* length, const uint32_t* width,
+                     const uint32_t* height, size_t count) {
+  Answer answer{};
+  for (size_t i{}; i < count; ++i) {
+    accumulate(answer, Box{length[i], width[i], height[i]});
+  }
+  return answer;
+}
+
+#ifdef AOC_DAY02_X86
+
+// adds the even and odd 32-bit lanes of `v` into four 64-bit lanes
+__attribute__((target("avx2"), always_inline)) inline __m256i widened_sum(
+    __m256i v) {
+  return _mm256_add_epi64(_mm256_and_si256(v, _mm256_set1_epi64x(0xffffffff)),
+                          _mm256_srli_epi64(v, 32));
+}
+
+__attribute__((target("avx2"))) Answer reduce_avx2(const uint32_t* length,
+                                                   const uint32_t* width,
+                                                   const uint32_t* height,
+                                                   size_t count) {
+  Answer answer{};
+  alignas(32) int64_t lanes[4];
+
+  size_t i{};
+  while (i + 8 <= count) {
+    // 64-bit partial totals, folded into `answer` before they can wrap
+    __m256i paper{_mm256_setzero_si256()};
+    __m256i ribbon{_mm256_setzero_si256()};
+
+    size_t end{std::min(count - count % 8, i + 8 * FOLD_STEPS)};
+    for (; i < end; i += 8) {
+      __m256i x{
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(length + i))};
+      __m256i y{
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(width + i))};
+      __m256i z{
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(height + i))};
+
+      // same network as `sort_sides`
+      __m256i low{_mm256_min_epu32(x, y)};
+      __m256i high{_mm256_max_epu32(x, y)};
+      __m256i middle{_mm256_min_epu32(high, z)};
+      __m256i c{_mm256_max_epu32(high, z)};
+      __m256i a{_mm256_min_epu32(low, middle)};
+      __m256i b{_mm256_max_epu32(low, middle)};
+
+      // sides are at most 16 bits, so the pairwise products are exact
+      __m256i ab{_mm256_mullo_epi32(a, b)};
+      __m256i bc{_mm256_mullo_epi32(b, c)};
+      __m256i ca{_mm256_mullo_epi32(c, a)};
+
+      // ab + 2 * (ab + bc + ca), summed after widening
+      __m256i smallest{widened_sum(ab)};
+      __m256i areas{_mm256_add_epi64(
+          smallest, _mm256_add_epi64(widened_sum(bc), widened_sum(ca)))};
+      paper = _mm256_add_epi64(
+          paper, _mm256_add_epi64(smallest, _mm256_add_epi64(areas, areas)));
+
+      // multiply even and odd lanes into 64-bit products for abc
+      __m256i abc_even{_mm256_mul_epu32(ab, c)};
+      __m256i abc_odd{_mm256_mul_epu32(_mm256_srli_epi64(ab, 32),
+                                       _mm256_srli_epi64(c, 32))};
+      __m256i perimeter{_mm256_slli_epi32(_mm256_add_epi32(a, b), 1)};
+      ribbon = _mm256_add_epi64(
+          ribbon, _mm256_add_epi64(_mm256_add_epi64(abc_even, abc_odd),
+                                   widened_sum(perimeter)));
+    }
+
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), paper);
+    for (int64_t lane : lanes) {
+      add(answer.wrapping_paper, lane);
+    }
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), ribbon);
+    for (int64_t lane : lanes) {
+      add(answer.ribbon, lane);
+    }
+  }
+
+  _mm256_zeroupper();
+  Answer tail{reduce_scalar(length + i, width + i, height + i, count - i)};
+  add(answer.wrapping_paper, tail.wrapping_paper);
+  add(answer.ribbon, tail.ribbon);
+  return answer;
+}
+
+#endif
+
+using ReduceFn = Answer (*)(const uint32_t*, const uint32_t*, const uint32_t*,
+                            size_t);
+
+ReduceFn select_reduce() {
+#ifdef AOC_DAY02_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return reduce_avx2;
+  }
+#endif
+  return reduce_scalar;
+}
+
+const ReduceFn reduce{select_reduce()};
+
+}  // namespace
+
+Boxes parse(std::string_view buffer) {
+  Boxes boxes{};
+  parse_into(boxes, buffer);
+  return boxes;
+}
+
+Answer solve(const Boxes& boxes) {
+  AOC_ALLOCATION_FREE("day02.solve");
+  return reduce(boxes.length.data(), boxes.width.data(), boxes.height.data(),
+                boxes.length.size());
+}
+
+Answer solve_parallel(std::string_view buffer, size_t threads) {
+  size_t chunks{std::min(threads * 4, buffer.size() / MIN_CHUNK_SIZE)};
+  if (threads <= 1 || chunks <= 1) {
+    return solve(parse(buffer));
+  }
+
+  // cut roughly evenly, then move each cut forward past the next newline
+  std::vector<std::string_view> views{};
+  size_t start{};
+  for (size_t i{1}; i <= chunks && start < buffer.size(); ++i) {
+    size_t cut{i == chunks ? buffer.size() : buffer.size() / chunks * i};
+    cut = std::max(cut, start);
+    size_t newline{buffer.find('\n', cut)};
+    size_t end{newline == std::string_view::npos ? buffer.size()
+                                                 : newline + 1};
+    views.push_back(buffer.substr(start, end - start));
+    start = end;
+  }
+
+  std::vector<Answer> answers(views.size());
+  {
+    aoc::ThreadPool pool{threads};
+    for (size_t i{}; i < views.size(); ++i) {
+      pool.submit([&views, &answers, i] {
+        answers[i] = solve(parse(views[i]));
+      });
+    }
+    pool.wait();
+  }
+
+  Answer answer{};
+  for (const Answer& part : answers) {
+    add(answer.wrapping_paper, part.wrapping_paper);
+    add(answer.ribbon, part.ribbon);
+  }
+  return answer;
+}
+
+Box parse_box(std::string_view line) {
+  size_t pos{};
+  uint32_t length{read_side(line, pos)};
+  expect(line, pos, 'x');
+  uint32_t width{read_side(line, pos)};
+  expect(line, pos, 'x');
+  uint32_t height{read_side(line, pos)};
+  if (pos != line.size()) {
+    throw std::runtime_error("expected 3 dimensions per line\n");
+  }
+  return Box{length, width, height};
+}
+
+void accumulate(Answer& answer, Box dims) {
+  auto [a, b, c] = dims;
+  sort_sides(a, b, c);
+
+  uint64_t ab{uint64_t{a} * b};
+  uint64_t bc{uint64_t{b} * c};
+  uint64_t ca{uint64_t{c} * a};
+
+  // 2*l*w + 2*w*h + 2*h*l + min_area
+  add(answer.wrapping_paper, static_cast<int64_t>(3 * ab + 2 * bc + 2 * ca));
+
+  // l*w*h + min_perimeter
+  add(answer.ribbon, static_cast<int64_t>(ab * c + 2 * (uint64_t{a} + b)));
+}
+
+void print(std::ostream& out, const Answer& answer) {
+  out << "Wrapping paper: " << answer.wrapping_paper << " sqft\n";
+  out << "Ribbon: " << answer.ribbon << " ft\n";
+}
+
+}  // namespace aoc2015::day02
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+namespace aoc2015::day02 {
+
+using Box = std::array<uint32_t, 3>;
+
+// dimensions stored column-wise so the reduction can load eight boxes at once
+struct Boxes {
+  std::vector<uint32_t> length;
+  std::vector<uint32_t> width;
+  std::vector<uint32_t> height;
+};
+
+struct Answer {
+  int64_t wrapping_paper;
+  int64_t ribbon;
+};
+
+Boxes parse(std::string_view buffer);
+Answer solve(const Boxes& boxes);
+
+// parse + solve with the buffer split into line-aligned chunks across
+// `threads` workers
+Answer solve_parallel(std::string_view buffer, size_t threads);
+
+// streaming form of parse + solve: one `LxWxH` line at a time
+Box parse_box(std::string_view line);
+void accumulate(Answer& answer, Box box);
+void print(std::ostream& out, const Answer& answer);
+
+}  // namespace aoc2015::day02
@@ -0,0 +1,448 @@
+#include "day03.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "../../common/alloc.hpp"
+#include "../../common/metrics.hpp"
+#include "../../common/thread_pool.hpp"
+
+/*
+    Advent of Code 2015 – Day 3
+
+  Problem:
+        Calculate the number of houses that received at least one present from
+        either Santa or Robo Santa
+
+    Approach:
+        Map input file into a `std::string_view`, and read character by character
+        Track Santa and Robo Santa's locations using even/odd indices, decoding
+  each move through a lookup table
+
+        Two passes over the moves:
+        - the first only tracks the bounding box of both walks
+        - the second marks every house in a visited set sized from that box:
+          a dense bitmap over the box when it costs no more than a few bytes
+          per move, otherwise an open-addressing table of packed 64-bit keys
+          (linear probing, kept at most half full)
+        Either way a house costs a bit or a slot instead of a heap node, and
+  the count of newly marked houses is the answer
+
+        With `--walkers K`, K deliverers take the moves round-robin. Each
+  walker is walked on its own thread into its own visited set over the shared
+  box, so nothing is shared while walking; the sets are then unioned in
+  parallel. Bitmaps are ORed and popcounted slice by slice; tables are split
+  into shards by a second hash while walking, so a house always lands in the
+  same shard and each shard merges independently of the others
+
+        `--stats` (with `-DAOC_METRICS=ON`) reports the engine used, the
+  houses found, the visited set's peak size in bytes and moves per second
+
+    Complexity:
+        O(n) time -- where n is the number of directions
+        O(min(box area, n)) space -- for the visited set, times K walkers
+*/
+
+namespace aoc2015::day03 {
+
+namespace {
+
+struct Point {
+  int64_t x;
+  int64_t y;
+};
+
+struct Bounds {
+  int64_t min_x{}, max_x{};
+  int64_t min_y{}, max_y{};
+
+  void include(const Point& point) {
+    min_x = std::min(min_x, point.x);
+    max_x = std::max(max_x, point.x);
+    min_y = std::min(min_y, point.y);
+    max_y = std::max(max_y, point.y);
+  }
+
+  uint64_t width() const { return static_cast<uint64_t>(max_x - min_x) + 1; }
+  uint64_t height() const { return static_cast<uint64_t>(max_y - min_y) + 1; }
+};
+
+struct Step {
+  int8_t dx;
+  int8_t dy;
+};
+
+constexpr std::array<Step, 256> STEPS{[] {
+  std::array<Step, 256> steps{};
+  steps['>'] = {1, 0};
+  steps['<'] = {-1, 0};
+  steps['^'] = {0, 1};
+  steps['v'] = {0, -1};
+  return steps;
+}()};
+
+// a bitmap costs box area / 8 bytes and a table up to 16 bytes per house;
+// take the bitmap while it costs at most 8 bytes per move, up to 512 MiB
+constexpr uint64_t DENSE_BITS_PER_MOVE{64};
+constexpr uint64_t MAX_DENSE_BITS{uint64_t{1} << 32};
+
+// calls visit(point) for the starting house and after every move, with
+// moves dealt alternately to Santa and Robo-Santa
+template <typename F>
+void walk(std::string_view moves, F&& visit) {
+  std::array<Point, 2> walkers{};
+  visit(walkers[0]);
+
+  for (size_t i{}; i < moves.size(); ++i) {
+    Point& walker{walkers[i & 1]};
+    Step step{STEPS[static_cast<unsigned char>(moves[i])]};
+    walker.x += step.dx;
+    walker.y += step.dy;
+    visit(walker);
+  }
+}
+
+class Bitmap {
+ public:
+  explicit Bitmap(const Bounds& bounds)
+      : bounds_{bounds},
+        words_((bounds.width() * bounds.height() + 63) / 64, 0) {}
+
+  // true if the house had not been marked yet
+  bool insert(const Point& point) {
+    uint64_t bit{static_cast<uint64_t>(point.y - bounds_.min_y) *
+                     bounds_.width() +
+                 static_cast<uint64_t>(point.x - bounds_.min_x)};
+    uint64_t& word{words_[bit / 64]};
+    uint64_t mask{uint64_t{1} << (bit % 64)};
+    bool fresh{(word & mask) == 0};
+    word |= mask;
+    return fresh;
+  }
+
+  size_t bytes() const { return words_.size() * sizeof(uint64_t); }
+  size_t words() const { return words_.size(); }
+
+  // houses marked in any of `bitmaps`, all laid out over the same box,
+  // within words [begin, end)
+  static size_t count_union(const std::vector<Bitmap>& bitmaps, size_t begin,
+                            size_t end) {
+    size_t marked{};
+    for (size_t i{begin}; i < end; ++i) {
+      uint64_t word{};
+      for (const Bitmap& bitmap : bitmaps) {
+        word |= bitmap.words_[i];
+      }
+      marked += static_cast<size_t>(std::popcount(word));
+    }
+    return marked;
+  }
+
+ private:
+  Bounds bounds_;
+  std::vector<uint64_t> words_;
+};
+
+class PointTable {
+ public:
+  // `capacity` must be a power of two
+  explicit PointTable(const Bounds& bounds,
+                      size_t capacity = INITIAL_CAPACITY)
+      : bounds_{bounds},
+        slots_(capacity, EMPTY),
+        shift_{64 - std::countr_zero(capacity)},
+        peak_bytes_{capacity * sizeof(uint64_t)} {}
+
+  // offsets from the box corner are non-negative and below 2^32, so the
+  // all-ones key can never occur and marks an empty slot
+  static uint64_t key(const Bounds& bounds, const Point& point) {
+    return static_cast<uint64_t>(point.x - bounds.min_x) << 32 |
+           static_cast<uint64_t>(point.y - bounds.min_y);
+  }
+
+  // true if the house had not been marked yet
+  bool insert(const Point& point) { return insert(key(bounds_, point)); }
+
+  bool insert(uint64_t key) {
+    for (size_t slot{hash(key)};; slot = (slot + 1) & (slots_.size() - 1)) {
+      if (slots_[slot] == key) {
+        return false;
+      }
+      if (slots_[slot] == EMPTY) {
+        slots_[slot] = key;
+        if (++size_ * 2 > slots_.size()) {
+          grow();
+        }
+        return true;
+      }
+    }
+  }
+
+  size_t bytes() const { return peak_bytes_; }
+  size_t size() const { return size_; }
+
+  template <typename F>
+  void for_each_key(F&& visit) const {
+    for (uint64_t key : slots_) {
+      if (key != EMPTY) {
+        visit(key);
+      }
+    }
+  }
+
+ private:
+  static constexpr uint64_t EMPTY{~uint64_t{}};
+  static constexpr size_t INITIAL_CAPACITY{1 << 12};
+
+  size_t hash(uint64_t key) const {
+    // Fibonacci hashing: the top bits of the product index the table
+    return static_cast<size_t>((key * 0x9e3779b97f4a7c15) >> shift_);
+  }
+
+  void grow() {
+    std::vector<uint64_t> old(slots_.size() * 2, EMPTY);
+    old.swap(slots_);
+    --shift_;
+    // both tables are alive during the rehash
+    peak_bytes_ = std::max(peak_bytes_,
+                           (old.size() + slots_.size()) * sizeof(uint64_t));
+
+    for (uint64_t key : old) {
+      if (key == EMPTY) {
+        continue;
+      }
+      size_t slot{hash(key)};
+      while (slots_[slot] != EMPTY) {
+        slot = (slot + 1) & (slots_.size() - 1);
+      }
+      slots_[slot] = key;
+    }
+  }
+
+  Bounds bounds_;
+  std::vector<uint64_t> slots_;
+  size_t size_{};
+  int shift_;  // 64 - log2(capacity)
+  size_t peak_bytes_;
+};
+
+template <typename Set>
+size_t count_houses(std::string_view moves, Set& visited) {
+  AOC_SCOPED_TIMER("day03.visit");
+  AOC_COUNT("day03.visit.moves", moves.size());
+
+  size_t houses{};
+  walk(moves, [&](const Point& point) { houses += visited.insert(point); });
+
+  AOC_COUNT("day03.houses", houses);
+  AOC_COUNT("day03.memory.peak_bytes", visited.bytes());
+  return houses;
+}
+
+// walks deliverer `first` of `walkers`: it takes moves first, first + walkers,
+// first + 2 * walkers, ...
+template <typename F>
+void walk_one(std::string_view moves, size_t first, size_t walkers,
+              F&& visit) {
+  Point walker{};
+  visit(walker);
+
+  for (size_t i{first}; i < moves.size(); i += walkers) {
+    Step step{STEPS[static_cast<unsigned char>(moves[i])]};
+    walker.x += step.dx;
+    walker.y += step.dy;
+    visit(walker);
+  }
+}
+
+// smaller slices of the bitmaps are not worth handing to another thread
+constexpr size_t MERGE_SLICE_WORDS{1 << 16};
+
+// per-walker tables start small: there are walkers * shards of them
+constexpr size_t SHARD_CAPACITY{1 << 8};
+
+// picks a key's shard from the top bits of a second multiplicative hash, so
+// the keys of one shard still spread over their table's slots
+size_t shard_of(uint64_t key, int shard_bits) {
+  return static_cast<size_t>((key * 0xff51afd7ed558ccd) >> (64 - shard_bits));
+}
+
+size_t union_bitmaps(std::string_view moves, const Bounds& bounds,
+                     size_t walkers, aoc::ThreadPool& pool) {
+  std::vector<Bitmap> visited{};
+  visited.reserve(walkers);
+  for (size_t w{}; w < walkers; ++w) {
+    visited.emplace_back(bounds);
+  }
+
+  {
+    AOC_SCOPED_TIMER("day03.walkers.walk");
+    for (size_t w{}; w < walkers; ++w) {
+      pool.submit([moves, walkers, w, &visited] {
+        Bitmap& own{visited[w]};
+        walk_one(moves, w, walkers,
+                 [&own](const Point& point) { own.insert(point); });
+      });
+    }
+    pool.wait();
+  }
+
+  AOC_SCOPED_TIMER("day03.walkers.merge");
+  size_t words{visited.front().words()};
+  std::vector<size_t> marked((words + MERGE_SLICE_WORDS - 1) /
+                             MERGE_SLICE_WORDS);
+  for (size_t i{}; i < marked.size(); ++i) {
+    pool.submit([&visited, &marked, words, i] {
+      size_t begin{i * MERGE_SLICE_WORDS};
+      marked[i] = Bitmap::count_union(
+          visited, begin, std::min(words, begin + MERGE_SLICE_WORDS));
+    });
+  }
+  pool.wait();
+
+  AOC_COUNT("day03.memory.peak_bytes", walkers * visited.front().bytes());
+  size_t houses{};
+  for (size_t count : marked) {
+    houses += count;
+  }
+  return houses;
+}
+
+size_t union_tables(std::string_view moves, const Bounds& bounds,
+                    size_t walkers, size_t threads, aoc::ThreadPool& pool) {
+  // several shards per thread keep the merge balanced
+  int shard_bits{
+      std::countr_zero(std::bit_ceil(std::max<size_t>(threads, 1) * 4))};
+  size_t shard_count{size_t{1} << shard_bits};
+
+  // shards[w][s] holds the houses walker w visited that hash to shard s
+  std::vector<std::vector<PointTable>> shards(walkers);
+  {
+    AOC_SCOPED_TIMER("day03.walkers.walk");
+    for (size_t w{}; w < walkers; ++w) {
+      pool.submit([moves, &bounds, walkers, w, shard_bits, shard_count,
+                   &shards] {
+        std::vector<PointTable>& own{shards[w]};
+        own.assign(shard_count, PointTable{bounds, SHARD_CAPACITY});
+        walk_one(moves, w, walkers, [&](const Point& point) {
+          uint64_t key{PointTable::key(bounds, point)};
+          own[shard_of(key, shard_bits)].insert(key);
+        });
+      });
+    }
+    pool.wait();
+  }
+
+  // a house lands in the same shard for every walker, so each shard is
+  // merged on its own, into walker 0's table
+  AOC_SCOPED_TIMER("day03.walkers.merge");
+  std::vector<size_t> marked(shard_count);
+  for (size_t s{}; s < shard_count; ++s) {
+    pool.submit([&shards, &marked, walkers, s] {
+      PointTable& merged{shards[0][s]};
+      for (size_t w{1}; w < walkers; ++w) {
+        shards[w][s].for_each_key([&merged](uint64_t key) {
+          merged.insert(key);
+        });
+      }
+      marked[s] = merged.size();
+    });
+  }
+  pool.wait();
+
+  size_t houses{};
+  size_t bytes{};
+  for (size_t s{}; s < shard_count; ++s) {
+    houses += marked[s];
+    for (size_t w{}; w < walkers; ++w) {
+      bytes += shards[w][s].bytes();
+    }
+  }
+  AOC_COUNT("day03.memory.peak_bytes", bytes);
+  return houses;
+}
+
+}  // namespace
+
+std::string_view parse(std::string_view buffer) { return buffer; }
+
+Answer solve(std::string_view moves) {
+  Bounds bounds{};
+  {
+    AOC_SCOPED_TIMER("day03.bounds");
+    AOC_ALLOCATION_FREE("day03.bounds");
+    walk(moves, [&bounds](const Point& point) { bounds.include(point); });
+  }
+
+  uint64_t dense_limit{
+      std::min(MAX_DENSE_BITS, DENSE_BITS_PER_MOVE * (moves.size() + 1))};
+  // divide rather than multiply: a long straight walk overflows the area
+  if (bounds.width() <= dense_limit / bounds.height()) {
+    AOC_COUNT("day03.engine.bitmap", 1);
+    Bitmap visited{bounds};
+    AOC_ALLOCATION_FREE("day03.visit");
+    return Answer{count_houses(moves, visited)};
+  }
+
+  AOC_COUNT("day03.engine.table", 1);
+  PointTable visited{bounds};
+  return Answer{count_houses(moves, visited)};
+}
+
+Answer solve_walkers(std::string_view moves, size_t walkers, size_t threads) {
+  if (walkers == 0) {
+    throw std::runtime_error("need at least one walker\n");
+  }
+
+  aoc::ThreadPool pool{threads};
+
+  std::vector<Bounds> walker_bounds(walkers);
+  {
+    AOC_SCOPED_TIMER("day03.walkers.bounds");
+    for (size_t w{}; w < walkers; ++w) {
+      pool.submit([moves, walkers, w, &walker_bounds] {
+        Bounds& own{walker_bounds[w]};
+        walk_one(moves, w, walkers,
+                 [&own](const Point& point) { own.include(point); });
+      });
+    }
+    pool.wait();
+  }
+
+  Bounds bounds{};
+  for (const Bounds& own : walker_bounds) {
+    bounds.include(Point{own.min_x, own.min_y});
+    bounds.include(Point{own.max_x, own.max_y});
+  }
+
+  AOC_COUNT("day03.walkers.walk.moves", moves.size());
+
+  // same budget as `solve`, shared by one bitmap per walker
+  uint64_t dense_limit{std::min(MAX_DENSE_BITS,
+                                DENSE_BITS_PER_MOVE * (moves.size() + 1)) /
+                       walkers};
+  size_t houses{};
+  if (bounds.width() <= dense_limit / bounds.height()) {
+    AOC_COUNT("day03.engine.bitmap", 1);
+    houses = union_bitmaps(moves, bounds, walkers, pool);
+  } else {
+    AOC_COUNT("day03.engine.table", 1);
+    houses = union_tables(moves, bounds, walkers, threads, pool);
+  }
+
+  AOC_COUNT("day03.houses", houses);
+  return Answer{houses};
+}
+
+void print(std::ostream& out, const Answer& answer) {
+  out << answer.houses << " houses received at least one present\n";
+}
+
+}  // namespace aoc2015::day03
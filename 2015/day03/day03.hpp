@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string_view>
+
+namespace aoc2015::day03 {
+
+struct Answer {
+  size_t houses;
+};
+
+std::string_view parse(std::string_view buffer);
+Answer solve(std::string_view moves);
+
+// `walkers` deliverers taking the moves round-robin (2 is `solve`), each
+// walked into its own visited set on one of `threads` workers, then unioned
+Answer solve_walkers(std::string_view moves, size_t walkers, size_t threads);
+void print(std::ostream& out, const Answer& answer);
+
+}  // namespace aoc2015::day03
@@ -1,26 +1,12 @@
-#include <fstream>
+#include <cstddef>
 #include <iostream>
-#include <stdexcept>
-#include <string>
-#include <unordered_set>
+#include <optional>
+#include <thread>
 
-/*
-    Advent of Code 2015 – Day 3
-
-  Problem:
-        Calculate the number of houses that received at least one present from
-        either Santa or Robo Santa
-
-    Approach:
-        Read input file into string buffer, and read character by character
-        Track Santa and Robo Santa's locations using even/odd indices
-        Use `std::unordered_set` to store unqiue coordinate pairs for visited
-  houses
-
-    Complexity:
-        O(n) time -- where n is the number of directions
-        O(n) space -- for storing unique house coordinates
-*/
+#include "../../common/args.hpp"
+#include "../../common/input.hpp"
+#include "../../common/metrics.hpp"
+#include "day03.hpp"
 
 int main(int argc, char* argv[]) {
   if (argc < 2) {
@@ -28,55 +14,38 @@ int main(int argc, char* argv[]) {
     return -1;
   }
 
-  std::ifstream file{argv[1], std::ios::ate};
-  if (!file.is_open()) {
-    throw std::runtime_error("could not open input file");
-  }
-
-  std::string buffer(file.tellg(), '\0');
-  file.seekg(0);
-  file.read(buffer.data(), buffer.size());
-
-  struct PairHash {
-    std::size_t operator()(const std::pair<int, int>& pair) const {
-      size_t h1{std::hash<int>{}(pair.first)};
-      size_t h2{std::hash<int>{}(pair.second)};
+  namespace day = aoc2015::day03;
 
-      return h1 ^ (h2 + 0x9e3779b9 + (h1 << 6) + (h1 >> 2));
+  std::optional<size_t> walkers{};
+  if (const char* value{aoc::option_value(argc, argv, "--walkers")}) {
+    walkers = aoc::positive_count(value);
+    if (!walkers.has_value()) {
+      std::cerr << value << ": --walkers needs a count of at least 1\n";
+      return -1;
     }
-  };
-  std::unordered_set<std::pair<int /* x-coordinate */, int /* y-coordinate */>,
-                     PairHash>
-      deliveries{};
-
-  int s_x{}, r_x{};
-  int s_y{}, r_y{};
-  deliveries.insert({s_x, s_y});  // initial delivery at starting location
-
-  for (size_t i{}; i < buffer.size(); ++i) {
-    int& x{(i % 2 == 0) ? s_x : r_x};
-    int& y{(i % 2 == 0) ? s_y : r_y};
+  }
 
-    switch (buffer[i]) {
-      case '>':
-        ++x;
-        break;
-      case '<':
-        --x;
-        break;
-      case '^':
-        ++y;
-        break;
-      case 'v':
-        --y;
-        break;
-      default:
-        break;
+  size_t threads{std::thread::hardware_concurrency()};
+  if (const char* value{aoc::option_value(argc, argv, "--threads")}) {
+    std::optional<size_t> count{aoc::positive_count(value)};
+    if (!count.has_value()) {
+      std::cerr << value << ": --threads needs a count of at least 1\n";
+      return -1;
     }
-    deliveries.insert({x, y});
+    threads = *count;
   }
 
-  std::cout << deliveries.size() << " houses received at least one present\n";
+  const aoc::Input input{argv[1]};
+  if (walkers.has_value()) {
+    day::print(std::cout,
+               day::solve_walkers(day::parse(input.view()), *walkers, threads));
+  } else {
+    day::print(std::cout, day::solve(day::parse(input.view())));
+  }
+
+  if (aoc::metrics::stats_requested(argc, argv)) {
+    aoc::metrics::report(std::cerr);
+  }
 
   return 0;
-}
\ No newline at end of file
+}
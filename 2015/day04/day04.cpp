@@ -0,0 +1,410 @@
+#include "day04.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "../../common/alloc.hpp"
+#include "../../common/input.hpp"
+#include "../../common/metrics.hpp"
+#include "../../common/thread_pool.hpp"
+#include "md5.hpp"
+
+/*
+    Advent of Code 2015 – Day 4
+
+  Problem:
+        Find the lowest positive number that produces an MD5 hash starting
+        with five or six leading zeros in hexadecimal
+
+    Approach:
+        Hash consecutive numbers together with the in-tree MD5 (`md5.hpp`):
+  one message per SIMD lane, 16 at a time with AVX-512, 8 with AVX2, 4 with
+  SSE2, picked at startup from the CPU's features
+        Each lane keeps its message (key, number, MD5 padding) in a fixed
+  block and steps the number's digits in place like an odometer; whole
+  64-byte blocks of the key are hashed once up front and every candidate
+  starts from that midstate
+        Check the first digest word for N leading zero hex digits with one
+  precomputed mask per difficulty. Every requested difficulty (both parts by
+  default) is tracked in the same pass: the answers only grow with the
+  difficulty, so a hash is tested against the easiest one not met yet, and
+  the search ends once the hardest is met
+
+        With `--threads N`, workers claim blocks of consecutive numbers from
+  an atomic counter and publish hits into an atomic minimum. Blocks are
+  claimed in increasing order, so once a worker claims a block starting at
+  or above the best hit for the hardest difficulty, every lower block has
+  already been claimed; the search ends when all workers have finished their
+  blocks, and the minimums are then the serial answers
+
+    Complexity:
+        O(k) time -- where k is the hardest difficulty's answer
+        O(1) space
+        O(k / p) span with p threads, plus up to one block per thread
+*/
+
+namespace aoc2015::day04 {
+
+namespace {
+
+constexpr int NONE{std::numeric_limits<int>::max()};
+
+// hex digits come most significant nibble first, while the digest's first
+// word holds its first four bytes least significant first: five zero digits
+// are the two low bytes and the next high nibble, 0x00f0ffff
+uint32_t zero_mask(int zeros) {
+  uint32_t mask{};
+  for (int digit{}; digit < zeros; ++digit) {
+    mask |= uint32_t{0xf} << (8 * (digit / 2) + (digit % 2 == 0 ? 4 : 0));
+  }
+  return mask;
+}
+
+// the requested difficulties, easiest first; a hash that meets one meets
+// every easier one too
+struct Difficulties {
+  std::array<int, MAX_ZEROS> zeros{};
+  std::array<uint32_t, MAX_ZEROS> masks{};
+  size_t count{};
+};
+
+Difficulties make_difficulties(std::span<const int> zeros) {
+  Difficulties wanted{};
+  for (int z : zeros) {
+    if (z < 1 || z > MAX_ZEROS) {
+      throw std::runtime_error("difficulty must be 1 to 8 leading zeros\n");
+    }
+    auto end{wanted.zeros.begin() + static_cast<ptrdiff_t>(wanted.count)};
+    if (std::find(wanted.zeros.begin(), end, z) == end) {
+      wanted.zeros[wanted.count++] = z;
+    }
+  }
+  if (wanted.count == 0) {
+    throw std::runtime_error("no difficulty requested\n");
+  }
+
+  std::sort(wanted.zeros.begin(),
+            wanted.zeros.begin() + static_cast<ptrdiff_t>(wanted.count));
+  for (size_t i{}; i < wanted.count; ++i) {
+    wanted.masks[i] = zero_mask(wanted.zeros[i]);
+  }
+  return wanted;
+}
+
+// first number meeting each difficulty, or NONE
+using Firsts = std::array<int, MAX_ZEROS>;
+
+Answer make_answer(const Difficulties& wanted, const Firsts& firsts) {
+  Answer answer{};
+  for (size_t i{}; i < wanted.count; ++i) {
+    if (firsts[i] == NONE) {
+      throw std::runtime_error("no matching hash below INT_MAX\n");
+    }
+    answer.hits.push_back(Hit{wanted.zeros[i], firsts[i]});
+  }
+  return answer;
+}
+
+// digits of the largest number a lane can be asked for
+constexpr size_t MAX_DIGITS{std::numeric_limits<int>::digits10 + 1};
+
+// what is left of the key after its whole blocks, plus the digits and the
+// padding, needs at most two blocks
+constexpr size_t MAX_TAIL_BLOCKS{2};
+
+md5::Kernel selected_kernel{md5::best_kernel()};
+
+size_t padded_blocks(size_t size) { return (size + 8) / 64 + 1; }
+
+uint32_t load_le(const char* bytes) {
+  return uint32_t{static_cast<uint8_t>(bytes[0])} |
+         uint32_t{static_cast<uint8_t>(bytes[1])} << 8 |
+         uint32_t{static_cast<uint8_t>(bytes[2])} << 16 |
+         uint32_t{static_cast<uint8_t>(bytes[3])} << 24;
+}
+
+// hashes `key` followed by a number, one number per lane. The key's whole
+// 64-byte blocks are hashed once into a midstate; every lane keeps the rest
+// of its message padded in place, and stepping its number works like a
+// decimal odometer: only the digits that change, and the block words that
+// hold them, are rewritten. Everything lives inline, so hashing never
+// allocates
+class Hasher {
+ public:
+  Hasher(std::string_view key, md5::Kernel kernel)
+      : kernel_{kernel}, lanes_{md5::lanes(kernel)} {
+    std::array<uint32_t, 16> words{};
+    for (; key.size() - prefix_size_ >= 64; prefix_size_ += 64) {
+      for (size_t w{}; w < 16; ++w) {
+        words[w] = load_le(key.data() + prefix_size_ + 4 * w);
+      }
+      md5::compress(md5::Kernel::SCALAR, midstate_.data(), words.data());
+    }
+
+    tail_size_ = key.size() - prefix_size_;
+    for (size_t lane{}; lane < lanes_; ++lane) {
+      std::copy(key.begin() + static_cast<ptrdiff_t>(prefix_size_), key.end(),
+                messages_[lane].begin());
+    }
+  }
+
+  size_t lanes() const { return lanes_; }
+
+  // puts first, first + 1, ... into the lanes
+  void seek(int64_t first) {
+    for (size_t lane{}; lane < lanes_; ++lane) {
+      numbers_[lane] = first + static_cast<int64_t>(lane);
+      write(lane);
+    }
+  }
+
+  // moves every lane `lanes()` numbers ahead
+  void advance() {
+    for (size_t lane{}; lane < lanes_; ++lane) {
+      step(lane, lanes_);
+    }
+  }
+
+  // word-major digests (see `md5::compress`) of the lanes' messages
+  const uint32_t* hash() {
+    size_t most_blocks{*std::max_element(blocks_.begin(),
+                                         blocks_.begin() +
+                                             static_cast<ptrdiff_t>(lanes_))};
+    for (size_t w{}; w < 4; ++w) {
+      std::fill_n(&state_[w * lanes_], lanes_, midstate_[w]);
+    }
+
+    for (size_t block{}; block < most_blocks; ++block) {
+      md5::compress(kernel_, state_.data(), &words_[block * 16 * lanes_]);
+
+      // lanes with shorter messages are done before the others; the extra
+      // block they go through afterwards is ignored
+      for (size_t lane{}; lane < lanes_; ++lane) {
+        if (blocks_[lane] == block + 1) {
+          for (size_t w{}; w < 4; ++w) {
+            digests_[w * lanes_ + lane] = state_[w * lanes_ + lane];
+          }
+        }
+      }
+    }
+    return digests_.data();
+  }
+
+ private:
+  // rewrites a lane's digits and padding from its number
+  void write(size_t lane) {
+    char* message{messages_[lane].data()};
+    char* digits{message + tail_size_};
+    size_t size{static_cast<size_t>(
+        std::to_chars(digits, digits + MAX_DIGITS, numbers_[lane]).ptr -
+        message)};
+
+    // 0x80, zeros, then the whole message's length in bits
+    size_t blocks{padded_blocks(size)};
+    std::fill(message + size, message + blocks * 64, 0);
+    message[size] = static_cast<char>(0x80);
+    uint64_t bits{uint64_t{prefix_size_ + size} * 8};
+    for (size_t i{}; i < 8; ++i) {
+      message[blocks * 64 - 8 + i] = static_cast<char>(bits >> (8 * i));
+    }
+
+    sizes_[lane] = size;
+    blocks_[lane] = blocks;
+    load_words(lane, 0, blocks * 16);
+  }
+
+  void step(size_t lane, size_t amount) {
+    numbers_[lane] += static_cast<int64_t>(amount);
+
+    char* message{messages_[lane].data()};
+    size_t pos{sizes_[lane]};
+    size_t carry{amount};
+    while (carry > 0) {
+      if (pos == tail_size_) {
+        // a new leading digit: the message grows, so rewrite it
+        write(lane);
+        return;
+      }
+      --pos;
+      size_t digit{static_cast<size_t>(message[pos] - '0') + carry};
+      message[pos] = static_cast<char>('0' + digit % 10);
+      carry = digit / 10;
+    }
+    load_words(lane, pos / 4, (sizes_[lane] - 1) / 4 + 1);
+  }
+
+  // transposes words [begin, end) of a lane's message into `words_`
+  void load_words(size_t lane, size_t begin, size_t end) {
+    for (size_t w{begin}; w < end; ++w) {
+      words_[w * lanes_ + lane] = load_le(&messages_[lane][4 * w]);
+    }
+  }
+
+  md5::Kernel kernel_;
+  size_t lanes_;
+  std::array<uint32_t, 4> midstate_{md5::INITIAL_STATE};
+  size_t prefix_size_{};  // key bytes already in the midstate
+  size_t tail_size_{};    // key bytes left in each lane's message
+
+  std::array<std::array<char, MAX_TAIL_BLOCKS * 64>, md5::MAX_LANES>
+      messages_{};
+  std::array<int64_t, md5::MAX_LANES> numbers_{};
+  std::array<size_t, md5::MAX_LANES> sizes_{};   // bytes before the padding
+  std::array<size_t, md5::MAX_LANES> blocks_{};  // blocks after padding
+
+  // word-major blocks, the second one only used by long tails
+  std::array<uint32_t, MAX_TAIL_BLOCKS * 16 * md5::MAX_LANES> words_{};
+  std::array<uint32_t, 4 * md5::MAX_LANES> state_{};
+  std::array<uint32_t, 4 * md5::MAX_LANES> digests_{};
+};
+
+// large enough that claiming a block is rare, small enough that the work
+// past the answer stays negligible
+constexpr int BLOCK_SIZE{1 << 12};
+
+// first number in [begin, end) meeting each difficulty; stops as soon as
+// the hardest one is met
+Firsts scan(Hasher& hasher, const Difficulties& wanted, int begin, int end) {
+  AOC_ALLOCATION_FREE("day04.search");
+  int64_t lanes{static_cast<int64_t>(hasher.lanes())};
+
+  Firsts firsts{};
+  firsts.fill(NONE);
+  // the first hits only get later as the difficulty rises, so the met
+  // difficulties are always the easiest ones and `next` is the rest's front
+  size_t next{};
+
+  hasher.seek(begin);
+  int64_t k{begin};
+  for (; k < end && next < wanted.count; k += lanes, hasher.advance()) {
+    const uint32_t* digests{hasher.hash()};
+    // lanes are in increasing order, so the first hit is the lowest
+    for (int64_t lane{}; lane < lanes && k + lane < end; ++lane) {
+      // one mask compare rejects nearly every hash
+      while (next < wanted.count &&
+             (digests[lane] & wanted.masks[next]) == 0) {
+        firsts[next++] = static_cast<int>(k + lane);
+      }
+    }
+  }
+  AOC_COUNT("day04.search.hashes", std::min<int64_t>(k, end) - begin);
+  return firsts;
+}
+
+void lower(std::atomic<int>& best, int candidate) {
+  int current{best.load(std::memory_order_relaxed)};
+  while (candidate < current &&
+         !best.compare_exchange_weak(current, candidate,
+                                     std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace
+
+void use_kernel(md5::Kernel next) {
+  if (!md5::supported(next)) {
+    throw std::runtime_error("kernel not supported on this CPU");
+  }
+  selected_kernel = next;
+}
+
+std::optional<int> verify(const std::string& key, md5::Kernel kernel,
+                          int count) {
+  Hasher hasher{key, kernel};
+  int64_t lanes{static_cast<int64_t>(hasher.lanes())};
+
+  hasher.seek(0);
+  for (int64_t k{}; k < count; k += lanes, hasher.advance()) {
+    const uint32_t* digests{hasher.hash()};
+    for (int64_t lane{}; lane < lanes; ++lane) {
+      md5::Digest expected{md5::digest(key + std::to_string(k + lane))};
+      for (size_t i{}; i < expected.size(); ++i) {
+        uint32_t word{digests[i / 4 * static_cast<size_t>(lanes) +
+                              static_cast<size_t>(lane)]};
+        if (static_cast<uint8_t>(word >> (8 * (i % 4))) != expected[i]) {
+          return static_cast<int>(k + lane);
+        }
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+std::string parse(std::string_view key) {
+  // the key may also be read from a file, so drop the trailing newline
+  return std::string(aoc::trim(key));
+}
+
+Answer solve(const std::string& key) { return solve_parallel(key, 1); }
+
+Answer solve_parallel(const std::string& key, size_t threads,
+                      std::span<const int> zeros) {
+  AOC_SCOPED_TIMER("day04.search");
+
+  Difficulties wanted{make_difficulties(zeros)};
+  if (threads <= 1) {
+    Hasher hasher{key, selected_kernel};
+    return make_answer(wanted, scan(hasher, wanted, 0, NONE));
+  }
+
+  constexpr int64_t LAST_BLOCK{NONE / BLOCK_SIZE};
+
+  std::atomic<int64_t> next_block{};
+  std::array<std::atomic<int>, MAX_ZEROS> best{};
+  for (std::atomic<int>& first : best) {
+    first.store(NONE, std::memory_order_relaxed);
+  }
+
+  {
+    aoc::ThreadPool pool{threads};
+    for (size_t i{}; i < threads; ++i) {
+      pool.submit([&key, &wanted, &next_block, &best] {
+        Hasher hasher{key, selected_kernel};
+        while (true) {
+          int64_t block{next_block.fetch_add(1, std::memory_order_relaxed)};
+          if (block >= LAST_BLOCK) {
+            return;
+          }
+          int begin{static_cast<int>(block * BLOCK_SIZE)};
+          // every later claim starts even higher, and no difficulty's
+          // answer lies past the hardest one's
+          if (begin >= best[wanted.count - 1].load(std::memory_order_relaxed)) {
+            return;
+          }
+
+          AOC_COUNT("day04.search.blocks", 1);
+          Firsts firsts{scan(hasher, wanted, begin, begin + BLOCK_SIZE)};
+          for (size_t d{}; d < wanted.count; ++d) {
+            lower(best[d], firsts[d]);
+          }
+        }
+      });
+    }
+    pool.wait();
+  }
+
+  Firsts firsts{};
+  for (size_t d{}; d < wanted.count; ++d) {
+    firsts[d] = best[d].load();
+  }
+  return make_answer(wanted, firsts);
+}
+
+void print(std::ostream& out, const Answer& answer) {
+  for (const Hit& hit : answer.hits) {
+    out << "lowest positive number with " << hit.zeros
+        << " leading zeros: " << hit.lowest << '\n';
+  }
+}
+
+}  // namespace aoc2015::day04
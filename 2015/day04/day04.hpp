@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "md5.hpp"
+
+namespace aoc2015::day04 {
+
+// leading zero hex digits asked for by the puzzle's two parts
+constexpr std::array<int, 2> DEFAULT_ZEROS{5, 6};
+
+// the digest's first word holds eight hex digits
+constexpr int MAX_ZEROS{8};
+
+struct Hit {
+  int zeros;
+  int lowest;
+};
+
+struct Answer {
+  std::vector<Hit> hits;  // easiest difficulty first
+};
+
+// switches MD5 kernels, e.g. to compare them; throws if the CPU lacks it
+void use_kernel(md5::Kernel kernel);
+
+// hashes key + 0 ... key + (count - 1) with `kernel` and returns the first
+// number whose digest differs from the scalar reference `md5::digest`
+std::optional<int> verify(const std::string& key, md5::Kernel kernel,
+                          int count);
+
+std::string parse(std::string_view key);
+Answer solve(const std::string& key);
+
+// lowest number for each difficulty in `zeros` (1 to MAX_ZEROS leading zero
+// hex digits), all found in one pass; with several `threads`, workers claim
+// blocks of numbers and the answers match the serial ones
+Answer solve_parallel(const std::string& key, size_t threads,
+                      std::span<const int> zeros = DEFAULT_ZEROS);
+void print(std::ostream& out, const Answer& answer);
+
+}  // namespace aoc2015::day04
@@ -1,25 +1,17 @@
-#include <openssl/md5.h>
-
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <exception>
 #include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
 
-/*
-    Advent of Code 2015 – Day 4
-
-  Problem:
-        Find the lowest positive number that produces an MD5 hash starting
-        with five or six leading zeros in hexadecimal
-
-    Approach:
-        Concatenate secret key with counter to form input string
-        Calculate MD5 hash of the input string using OpenSSL
-        Check bytes of hash for leading zeros without full hex conversion
-
-    Complexity:
-        O(k) time -- where k is the answer (number of iterations needed)
-        O(1) space
-*/
-
-bool check_hash(unsigned char* hash);
+#include "../../common/args.hpp"
+#include "../../common/metrics.hpp"
+#include "day04.hpp"
 
 int main(int argc, char* argv[]) {
   if (argc < 2) {
@@ -27,34 +19,95 @@ int main(int argc, char* argv[]) {
     return -1;
   }
 
-  const std::string key{std::string(argv[1])};
+  namespace day = aoc2015::day04;
+  namespace md5 = aoc2015::day04::md5;
 
-  int k{};
-  while (true) {
-    unsigned char hash[16];
-    std::string input{key + std::to_string(k)};
+  constexpr std::array KERNELS{md5::Kernel::SCALAR, md5::Kernel::SSE2,
+                               md5::Kernel::AVX2, md5::Kernel::AVX512};
 
-    // openssl MD5 implementation
-    MD5(reinterpret_cast<const unsigned char*>(input.c_str()), input.size(),
-        hash);
+  // checks every kernel the CPU supports against the scalar reference
+  if (aoc::has_flag(argc, argv, "--verify")) {
+    constexpr int COUNT{100'000};
+    bool ok{true};
+    for (md5::Kernel kernel : KERNELS) {
+      if (!md5::supported(kernel)) {
+        continue;
+      }
+      std::optional<int> mismatch{day::verify(day::parse(argv[1]), kernel,
+                                              COUNT)};
+      std::cout << md5::kernel_name(kernel) << ": ";
+      if (mismatch.has_value()) {
+        std::cout << "digest of " << *mismatch << " differs\n";
+        ok = false;
+      } else {
+        std::cout << COUNT << " digests match\n";
+      }
+    }
+    return ok ? 0 : 1;
+  }
 
-    if (check_hash(hash)) {
-      break;
+  if (const char* name{aoc::option_value(argc, argv, "--kernel")}) {
+    auto kernel{std::ranges::find_if(KERNELS, [name](md5::Kernel k) {
+      return md5::kernel_name(k) == name;
+    })};
+    try {
+      if (kernel == KERNELS.end()) {
+        throw std::runtime_error(
+            "unknown kernel (scalar, sse2, avx2 or avx512)");
+      }
+      day::use_kernel(*kernel);
+    } catch (const std::exception& e) {
+      std::cerr << name << ": " << e.what() << '\n';
+      return -1;
     }
-    ++k;
   }
 
-  std::cout << "lowest positive number: " << k << '\n';
+  const char* threads{aoc::option_value(argc, argv, "--threads")};
+  const char* zeros{aoc::option_value(argc, argv, "--zeros")};
+  if (threads != nullptr || zeros != nullptr) {
+    size_t workers{1};
+    if (threads != nullptr) {
+      std::optional<size_t> count{aoc::positive_count(threads)};
+      if (!count.has_value()) {
+        std::cerr << threads << ": --threads needs a count of at least 1\n";
+        return -1;
+      }
+      workers = *count;
+    }
 
-  return 0;
-}
+    // a comma-separated list of difficulties, e.g. 5,6,7
+    std::vector<int> difficulties{};
+    for (std::string_view rest{zeros != nullptr ? zeros : ""};
+         !rest.empty();) {
+      size_t comma{rest.find(',')};
+      std::string_view token{rest.substr(0, comma)};
+      rest = comma == std::string_view::npos ? std::string_view{}
+                                             : rest.substr(comma + 1);
 
-bool check_hash(unsigned char* hash) {
-  /*
-  to check a hash that with 5 zeros in hex
-  return hash[0] == 0 && hash[1] == 0 && hash[2] < 16;
-  */
+      int value{};
+      auto [ptr, ec]{
+          std::from_chars(token.data(), token.data() + token.size(), value)};
+      if (ec != std::errc{} || ptr != token.data() + token.size() ||
+          value < 1 || value > day::MAX_ZEROS) {
+        std::cerr << zeros << ": expected difficulties from 1 to "
+                  << day::MAX_ZEROS << " separated by commas\n";
+        return -1;
+      }
+      difficulties.push_back(value);
+    }
+    if (difficulties.empty()) {
+      difficulties.assign(day::DEFAULT_ZEROS.begin(), day::DEFAULT_ZEROS.end());
+    }
+
+    day::print(std::cout, day::solve_parallel(day::parse(argv[1]), workers,
+                                              difficulties));
+  } else {
+    day::print(std::cout, day::solve(day::parse(argv[1])));
+  }
 
-  // to check a hash that with 6 zeros in hex
-  return hash[0] == 0 && hash[1] == 0 && hash[2] < 16;
-}
\ No newline at end of file
+  if (aoc::metrics::stats_requested(argc, argv)) {
+    aoc::metrics::report(std::cerr);
+  }
+
+  return 0;
+}
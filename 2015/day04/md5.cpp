@@ -0,0 +1,238 @@
+#include "md5.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#ifdef __x86_64__
+#define AOC_MD5_X86 1
+#endif
+
+namespace aoc2015::day04::md5 {
+
+namespace {
+
+// per-step additive constants, floor(abs(sin(i + 1)) * 2^32)
+constexpr std::array<uint32_t, 64> K{
+    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a,
+    0xa8304613, 0xfd469501, 0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be,
+    0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821, 0xf61e2562, 0xc040b340,
+    0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8,
+    0x676f02d9, 0x8d2a4c8a, 0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c,
+    0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70, 0x289b7ec6, 0xeaa127fa,
+    0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92,
+    0xffeff47d, 0x85845dd1, 0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1,
+    0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391};
+
+// per-step left rotations
+constexpr std::array<int, 64> SHIFTS{
+    7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+    5, 9,  14, 20, 5, 9,  14, 20, 5, 9,  14, 20, 5, 9,  14, 20,
+    4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+    6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21};
+
+// one lane is a plain uint32_t; wider kernels use GCC/Clang vector types,
+// whose operators compile to whatever the calling function's target allows
+#ifdef AOC_MD5_X86
+typedef uint32_t Lanes4 __attribute__((vector_size(16)));
+typedef uint32_t Lanes8 __attribute__((vector_size(32)));
+typedef uint32_t Lanes16 __attribute__((vector_size(64)));
+#endif
+
+// the whole compression function for one vector of lanes; always inlined
+// into the per-target wrappers below, so it is compiled once per target
+template <typename V>
+__attribute__((always_inline)) inline void compress_lanes(
+    uint32_t* state, const uint32_t* block) {
+  constexpr size_t LANES{sizeof(V) / sizeof(uint32_t)};
+
+  V words[16];
+  for (size_t w{}; w < 16; ++w) {
+    std::memcpy(&words[w], block + w * LANES, sizeof(V));
+  }
+  V a, b, c, d;
+  std::memcpy(&a, state + 0 * LANES, sizeof(V));
+  std::memcpy(&b, state + 1 * LANES, sizeof(V));
+  std::memcpy(&c, state + 2 * LANES, sizeof(V));
+  std::memcpy(&d, state + 3 * LANES, sizeof(V));
+  V aa{a}, bb{b}, cc{c}, dd{d};
+
+#pragma GCC unroll 64
+  for (size_t i{}; i < 64; ++i) {
+    V f;
+    size_t g;
+    if (i < 16) {
+      f = (b & c) | (~b & d);
+      g = i;
+    } else if (i < 32) {
+      f = (d & b) | (~d & c);
+      g = (5 * i + 1) % 16;
+    } else if (i < 48) {
+      f = b ^ c ^ d;
+      g = (3 * i + 5) % 16;
+    } else {
+      f = c ^ (b | ~d);
+      g = (7 * i) % 16;
+    }
+
+    V t = a + f + K[i] + words[g];
+    a = d;
+    d = c;
+    c = b;
+    b = b + ((t << SHIFTS[i]) | (t >> (32 - SHIFTS[i])));
+  }
+
+  a += aa;
+  b += bb;
+  c += cc;
+  d += dd;
+  std::memcpy(state + 0 * LANES, &a, sizeof(V));
+  std::memcpy(state + 1 * LANES, &b, sizeof(V));
+  std::memcpy(state + 2 * LANES, &c, sizeof(V));
+  std::memcpy(state + 3 * LANES, &d, sizeof(V));
+}
+
+void compress_scalar(uint32_t* state, const uint32_t* block) {
+  compress_lanes<uint32_t>(state, block);
+}
+
+#ifdef AOC_MD5_X86
+
+// SSE2 is part of the x86-64 baseline, so this needs no target attribute
+void compress_sse2(uint32_t* state, const uint32_t* block) {
+  compress_lanes<Lanes4>(state, block);
+}
+
+__attribute__((target("avx2"))) void compress_avx2(uint32_t* state,
+                                                   const uint32_t* block) {
+  compress_lanes<Lanes8>(state, block);
+}
+
+__attribute__((target("avx512f"))) void compress_avx512(
+    uint32_t* state, const uint32_t* block) {
+  compress_lanes<Lanes16>(state, block);
+}
+
+#endif
+
+uint32_t load_le(const uint8_t* bytes) {
+  return uint32_t{bytes[0]} | uint32_t{bytes[1]} << 8 |
+         uint32_t{bytes[2]} << 16 | uint32_t{bytes[3]} << 24;
+}
+
+}  // namespace
+
+size_t lanes(Kernel kernel) {
+  switch (kernel) {
+    case Kernel::SSE2:
+      return 4;
+    case Kernel::AVX2:
+      return 8;
+    case Kernel::AVX512:
+      return 16;
+    default:
+      return 1;
+  }
+}
+
+bool supported(Kernel kernel) {
+  switch (kernel) {
+    case Kernel::SCALAR:
+      return true;
+#ifdef AOC_MD5_X86
+    case Kernel::SSE2:
+      return true;
+    case Kernel::AVX2:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2");
+    case Kernel::AVX512:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx512f");
+#endif
+    default:
+      return false;
+  }
+}
+
+Kernel best_kernel() {
+  for (Kernel kernel : {Kernel::AVX512, Kernel::AVX2, Kernel::SSE2}) {
+    if (supported(kernel)) {
+      return kernel;
+    }
+  }
+  return Kernel::SCALAR;
+}
+
+std::string_view kernel_name(Kernel kernel) {
+  switch (kernel) {
+    case Kernel::AVX512:
+      return "avx512";
+    case Kernel::AVX2:
+      return "avx2";
+    case Kernel::SSE2:
+      return "sse2";
+    default:
+      return "scalar";
+  }
+}
+
+void compress(Kernel kernel, uint32_t* state, const uint32_t* block) {
+  switch (kernel) {
+#ifdef AOC_MD5_X86
+    case Kernel::SSE2:
+      return compress_sse2(state, block);
+    case Kernel::AVX2:
+      return compress_avx2(state, block);
+    case Kernel::AVX512:
+      return compress_avx512(state, block);
+#endif
+    default:
+      return compress_scalar(state, block);
+  }
+}
+
+Digest digest(std::string_view message) {
+  std::array<uint32_t, 4> state{INITIAL_STATE};
+  std::array<uint32_t, 16> words{};
+
+  // whole blocks straight from the message, then one or two padded ones
+  const auto* bytes{reinterpret_cast<const uint8_t*>(message.data())};
+  size_t pos{};
+  for (; message.size() - pos >= 64; pos += 64) {
+    for (size_t w{}; w < 16; ++w) {
+      words[w] = load_le(bytes + pos + 4 * w);
+    }
+    compress_scalar(state.data(), words.data());
+  }
+
+  std::array<uint8_t, 128> tail{};
+  size_t rest{message.size() - pos};
+  if (rest > 0) {
+    std::memcpy(tail.data(), bytes + pos, rest);
+  }
+  tail[rest] = 0x80;
+  size_t tail_size{rest + 9 <= 64 ? size_t{64} : size_t{128}};
+  uint64_t bits{uint64_t{message.size()} * 8};
+  for (size_t i{}; i < 8; ++i) {
+    tail[tail_size - 8 + i] = static_cast<uint8_t>(bits >> (8 * i));
+  }
+
+  for (size_t block{}; block < tail_size; block += 64) {
+    for (size_t w{}; w < 16; ++w) {
+      words[w] = load_le(tail.data() + block + 4 * w);
+    }
+    compress_scalar(state.data(), words.data());
+  }
+
+  Digest result{};
+  for (size_t i{}; i < 16; ++i) {
+    result[i] = static_cast<uint8_t>(state[i / 4] >> (8 * (i % 4)));
+  }
+  return result;
+}
+
+}  // namespace aoc2015::day04::md5
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/*
+    MD5 (RFC 1321) compression across SIMD lanes
+
+    One call of `compress` runs one 64-byte block of several independent
+    messages through the compression function at once: 4 lanes with SSE2,
+    8 with AVX2 and 16 with AVX-512, or a single one with the scalar kernel.
+    Callers pad the messages themselves and keep the state between blocks.
+
+    `digest` is a plain scalar MD5 of a whole message, kept as the reference
+    the lane kernels are checked against.
+*/
+
+namespace aoc2015::day04::md5 {
+
+enum class Kernel { SCALAR, SSE2, AVX2, AVX512 };
+
+constexpr size_t MAX_LANES{16};
+
+constexpr std::array<uint32_t, 4> INITIAL_STATE{0x67452301, 0xefcdab89,
+                                                0x98badcfe, 0x10325476};
+
+using Digest = std::array<uint8_t, 16>;
+
+// messages hashed per `compress` call
+size_t lanes(Kernel kernel);
+
+bool supported(Kernel kernel);
+Kernel best_kernel();
+std::string_view kernel_name(Kernel kernel);
+
+// both arrays are word-major: word w of lane l is at [w * lanes(kernel) + l],
+// for the 4 state words and the 16 little-endian words of each lane's block
+void compress(Kernel kernel, uint32_t* state, const uint32_t* block);
+
+Digest digest(std::string_view message);
+
+}  // namespace aoc2015::day04::md5
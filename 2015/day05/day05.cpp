@@ -0,0 +1,181 @@
+#include "day05.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include "../../common/alloc.hpp"
+
+/*
+    Advent of Code 2015 – Day 5
+
+    Problem:
+        Determine if strings are "nice" based on two different rule sets.
+
+    Approach:
+        Map entire input file and parse through a `std::string_view` to
+   avoid copies
+
+        Both rule sets are checked together in one pass over each string,
+   with table lookups instead of searches:
+            Old rules
+            - count vowels through a 256-entry table
+            - a character equal to the one before it is a double letter
+            - "ab", "cd", "pq" and "xy" are flagged by the first letter plus
+              an increment check
+            New rules
+            - a flat 26x26 table, indexed by (a - 'a') * 26 + (b - 'a'),
+              holds the first position of each letter pair; a pair seen
+              again at least 2 characters later repeats without overlap
+            - a character equal to the one two before it is an xyx
+        Each table slot carries the epoch (string number) it was written in,
+   so moving to the next string resets the pair table by bumping the epoch
+   rather than clearing 676 slots, and nothing is allocated per string
+
+        With `--stream`, each string is classified as it is read
+
+    Complexity:
+        O(n*m) time -- where n is number of strings, m is average string length
+        O(1) space -- a fixed 676-slot pair table
+*/
+
+namespace aoc2015::day05 {
+
+namespace {
+
+constexpr size_t LETTERS{26};
+constexpr uint8_t NOT_A_LETTER{0xff};
+
+constexpr std::array<uint8_t, 256> LETTER_INDEX{[] {
+  std::array<uint8_t, 256> index{};
+  index.fill(NOT_A_LETTER);
+  for (size_t i{}; i < LETTERS; ++i) {
+    index['a' + i] = static_cast<uint8_t>(i);
+  }
+  return index;
+}()};
+
+constexpr std::array<bool, 256> VOWEL{[] {
+  std::array<bool, 256> vowel{};
+  for (unsigned char c : std::string_view{"aeiou"}) {
+    vowel[c] = true;
+  }
+  return vowel;
+}()};
+
+// first letters of the forbidden pairs "ab", "cd", "pq" and "xy", each
+// followed by the next letter
+constexpr std::array<bool, 256> FORBIDDEN_FIRST{[] {
+  std::array<bool, 256> first{};
+  for (unsigned char c : std::string_view{"acpx"}) {
+    first[c] = true;
+  }
+  return first;
+}()};
+
+struct Verdict {
+  bool old_rules;
+  bool new_rules;
+};
+
+class Classifier {
+ public:
+  Verdict classify(std::string_view line) {
+    // a new epoch invalidates every pair seen in earlier strings
+    ++epoch_;
+
+    size_t vowels{};
+    bool doubled{};
+    bool forbidden{};
+    bool pair_twice{};
+    bool xyx{};
+
+    for (size_t i{}; i < line.size(); ++i) {
+      auto c{static_cast<unsigned char>(line[i])};
+      vowels += VOWEL[c];
+      if (i == 0) {
+        continue;
+      }
+
+      auto before{static_cast<unsigned char>(line[i - 1])};
+      doubled |= c == before;
+      forbidden |= FORBIDDEN_FIRST[before] && c == before + 1;
+      xyx |= i >= 2 && static_cast<unsigned char>(line[i - 2]) == c;
+
+      uint8_t first{LETTER_INDEX[before]};
+      uint8_t second{LETTER_INDEX[c]};
+      if (first == NOT_A_LETTER || second == NOT_A_LETTER) {
+        continue;
+      }
+      Slot& slot{pairs_[first * LETTERS + second]};
+      if (slot.epoch != epoch_) {
+        slot = Slot{epoch_, i - 1};
+      } else if ((i - 1) - slot.position >= 2) {
+        pair_twice = true;
+      }
+    }
+
+    return Verdict{vowels >= 3 && doubled && !forbidden, pair_twice && xyx};
+  }
+
+ private:
+  struct Slot {
+    uint64_t epoch;
+    size_t position;  // of the pair's first occurrence in that epoch
+  };
+
+  std::array<Slot, LETTERS * LETTERS> pairs_{};
+  uint64_t epoch_{};
+};
+
+void count(Answer& answer, Verdict verdict) {
+  answer.nice_old_rules += verdict.old_rules;
+  answer.nice_new_rules += verdict.new_rules;
+}
+
+}  // namespace
+
+std::vector<std::string_view> parse(std::string_view buffer) {
+  std::vector<std::string_view> strings{};
+
+  size_t pos{};
+  while (pos < buffer.size()) {
+    size_t end{buffer.find('\n', pos)};
+    if (end == std::string_view::npos) {
+      end = buffer.size();
+    }
+
+    strings.emplace_back(buffer.data() + pos, end - pos);
+
+    pos = end + 1;
+  }
+
+  return strings;
+}
+
+Answer solve(const std::vector<std::string_view>& strings) {
+  AOC_ALLOCATION_FREE("day05.solve");
+
+  Classifier classifier{};
+  Answer answer{};
+  for (std::string_view line : strings) {
+    count(answer, classifier.classify(line));
+  }
+  return answer;
+}
+
+void accumulate(Answer& answer, std::string_view line) {
+  // keeps its pair table, and epoch, across calls
+  thread_local Classifier classifier{};
+  count(answer, classifier.classify(line));
+}
+
+void print(std::ostream& out, const Answer& answer) {
+  out << answer.nice_old_rules << " strings are nice under the old rules\n";
+  out << answer.nice_new_rules << " strings are nice under the new rules\n";
+}
+
+}  // namespace aoc2015::day05
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+namespace aoc2015::day05 {
+
+struct Answer {
+  int64_t nice_old_rules;  // part 1
+  int64_t nice_new_rules;  // part 2
+};
+
+std::vector<std::string_view> parse(std::string_view buffer);
+Answer solve(const std::vector<std::string_view>& strings);
+
+// streaming form of `solve`: classifies one string at a time
+void accumulate(Answer& answer, std::string_view line);
+void print(std::ostream& out, const Answer& answer);
+
+}  // namespace aoc2015::day05
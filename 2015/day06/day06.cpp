@@ -0,0 +1,578 @@
+#include "day06.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#ifdef __x86_64__
+#include <immintrin.h>
+#define AOC_DAY06_X86 1
+#endif
+
+#include "../../common/alloc.hpp"
+#include "../../common/metrics.hpp"
+#include "../../common/scan.hpp"
+#include "../../common/thread_pool.hpp"
+
+/*
+    Advent of Code 2015 – Day 6
+
+    Problem:
+        Read in instructions to turn on, turn off, or toggle light in a
+   1000x1000 grid (or whatever size the largest coordinate calls for).
+
+        Part 1: Count lights that are on
+        Part 2: Sum and track brightness levels
+
+    Approach:
+        Map entire input file and parse through a `std::string_view`
+
+        Parse each instruction using `aoc::scan` to extract:
+        - Action type (turn on, turn off, toggle)
+        - Coordinate ranges (x1,y1 through x2,y2)
+
+        Both parts are replayed in the same pass over the instructions, on
+   two contiguous grids sized from the largest coordinate (1000x1000 for the
+   puzzle):
+        - Part 1: a bitset, one bit per light and whole 64-bit words per row.
+          A row span becomes word-wide OR (on), AND-NOT (off) or XOR
+          (toggle), with masks for the partial words at either edge; the
+          answer is a popcount
+        - Part 2: a brightness plane of 16-bit cells, updated 16 (AVX2) or 8
+          (SSE2) at a time with saturating adds and subtracts, picked at
+          runtime. Saturating subtraction is exactly "never below zero";
+          16 bits hold any brightness when there are at most 32767
+          instructions, and longer inputs switch to 32-bit cells
+        The action is dispatched once per instruction, never per light
+
+        Huge, sparse grids (say 10^6 x 10^6 with a few hundred rectangles)
+   go to a sweep instead: the rectangles' x and y edges cut the plane into
+   compressed bands, and each column band replays, in input order, only the
+   instructions covering it over one column of compressed row cells; every
+   cell then counts for its band's width times its height. Instructions
+   enter and leave a bitset of active ones as the sweep passes their edges.
+   Memory is linear in the number of distinct coordinates. The engine is
+   picked from the grid's area against the compressed grid's (unless
+   forced with `--engine dense|sweep`)
+
+        With `--threads N`, the dense grid is cut into N bands of rows.
+   Lights in different rows never interact, so each thread replays the whole
+   instruction list, clipped to its own rows, on grids of its own: nothing
+   is shared or locked, and a band's grids are small enough to stay in
+   cache. `--stats` lists every band's time and cells, and how much slower
+   the slowest band was than the mean
+
+    Complexity:
+        O(n*a) time -- where n is number of instructions, a is average area per
+   instruction (a / 64 words for part 1)
+        O(w*h) space -- for the two grids
+        sweep: O(n * X * Y) time worst case, O(n + X + Y) space -- for X and
+   Y distinct edges along each axis
+*/
+
+namespace aoc2015::day06 {
+
+namespace {
+
+// the dense grids take about 2 bytes per light
+constexpr double MAX_DENSE_LIGHTS{1 << 26};
+
+// dense cells are updated 16 to 64 at a time, compressed cells one by one
+constexpr double DENSE_ADVANTAGE{16};
+
+Engine selected_engine{Engine::AUTO};
+
+// one bit per light, rows padded to whole words
+class LightGrid {
+ public:
+  LightGrid(size_t width, size_t height)
+      : words_per_row_{(width + 63) / 64}, words_(words_per_row_ * height) {}
+
+  void apply(const Instruction& instruction) {
+    switch (instruction.action) {
+      case Action::TURN_ON:
+        return apply(instruction, [](uint64_t& word, uint64_t mask) {
+          word |= mask;
+        });
+      case Action::TURN_OFF:
+        return apply(instruction, [](uint64_t& word, uint64_t mask) {
+          word &= ~mask;
+        });
+      case Action::TOGGLE:
+        return apply(instruction, [](uint64_t& word, uint64_t mask) {
+          word ^= mask;
+        });
+    }
+  }
+
+  size_t count() const {
+    size_t lit{};
+    for (uint64_t word : words_) {
+      lit += static_cast<size_t>(std::popcount(word));
+    }
+    return lit;
+  }
+
+ private:
+  template <typename Op>
+  void apply(const Instruction& instruction, Op op) {
+    const auto& [action, x_1, y_1, x_2, y_2] = instruction;
+    size_t first{x_1 / 64};
+    size_t last{x_2 / 64};
+    uint64_t first_mask{~uint64_t{} << (x_1 % 64)};
+    uint64_t last_mask{~uint64_t{} >> (63 - x_2 % 64)};
+
+    for (size_t y{y_1}; y <= y_2; ++y) {
+      uint64_t* row{&words_[y * words_per_row_]};
+      if (first == last) {
+        op(row[first], first_mask & last_mask);
+        continue;
+      }
+      op(row[first], first_mask);
+      for (size_t w{first + 1}; w < last; ++w) {
+        op(row[w], ~uint64_t{});
+      }
+      op(row[last], last_mask);
+    }
+  }
+
+  size_t words_per_row_;
+  std::vector<uint64_t> words_;
+};
+
+// brightness of a span of cells after one action
+template <typename Cell>
+void brighten_scalar(Cell* cells, size_t size, Action action) {
+  switch (action) {
+    case Action::TURN_ON:
+      for (size_t i{}; i < size; ++i) {
+        cells[i] += 1;
+      }
+      break;
+    case Action::TURN_OFF:
+      for (size_t i{}; i < size; ++i) {
+        cells[i] -= cells[i] != 0;
+      }
+      break;
+    case Action::TOGGLE:
+      for (size_t i{}; i < size; ++i) {
+        cells[i] += 2;
+      }
+      break;
+  }
+}
+
+using Brighten16Fn = void (*)(uint16_t* cells, size_t size, Action action);
+
+#ifdef AOC_DAY06_X86
+
+// SSE2 is part of the x86-64 baseline, so this needs no target attribute
+void brighten_sse2(uint16_t* cells, size_t size, Action action) {
+  const __m128i step{_mm_set1_epi16(action == Action::TOGGLE ? 2 : 1)};
+  size_t i{};
+  if (action == Action::TURN_OFF) {
+    for (; i + 8 <= size; i += 8) {
+      auto* at{reinterpret_cast<__m128i*>(cells + i)};
+      _mm_storeu_si128(at, _mm_subs_epu16(_mm_loadu_si128(at), step));
+    }
+  } else {
+    for (; i + 8 <= size; i += 8) {
+      auto* at{reinterpret_cast<__m128i*>(cells + i)};
+      _mm_storeu_si128(at, _mm_adds_epu16(_mm_loadu_si128(at), step));
+    }
+  }
+  brighten_scalar(cells + i, size - i, action);
+}
+
+__attribute__((target("avx2"))) void brighten_avx2(uint16_t* cells,
+                                                   size_t size,
+                                                   Action action) {
+  const __m256i step{_mm256_set1_epi16(action == Action::TOGGLE ? 2 : 1)};
+  size_t i{};
+  if (action == Action::TURN_OFF) {
+    for (; i + 16 <= size; i += 16) {
+      auto* at{reinterpret_cast<__m256i*>(cells + i)};
+      _mm256_storeu_si256(at, _mm256_subs_epu16(_mm256_loadu_si256(at), step));
+    }
+  } else {
+    for (; i + 16 <= size; i += 16) {
+      auto* at{reinterpret_cast<__m256i*>(cells + i)};
+      _mm256_storeu_si256(at, _mm256_adds_epu16(_mm256_loadu_si256(at), step));
+    }
+  }
+  // the tail runs legacy-encoded SSE code
+  _mm256_zeroupper();
+  brighten_sse2(cells + i, size - i, action);
+}
+
+#endif
+
+Brighten16Fn select_brighten16() {
+#ifdef AOC_DAY06_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return brighten_avx2;
+  }
+  return brighten_sse2;
+#else
+  return brighten_scalar<uint16_t>;
+#endif
+}
+
+const Brighten16Fn brighten16{select_brighten16()};
+
+// one brightness per light, rows back to back
+template <typename Cell>
+class BrightnessPlane {
+ public:
+  BrightnessPlane(size_t width, size_t height)
+      : width_{width}, cells_(width * height) {}
+
+  void apply(const Instruction& instruction) {
+    const auto& [action, x_1, y_1, x_2, y_2] = instruction;
+    for (size_t y{y_1}; y <= y_2; ++y) {
+      Cell* span{&cells_[y * width_ + x_1]};
+      if constexpr (sizeof(Cell) == sizeof(uint16_t)) {
+        brighten16(span, x_2 - x_1 + 1, action);
+      } else {
+        brighten_scalar(span, x_2 - x_1 + 1, action);
+      }
+    }
+  }
+
+  int64_t total() const {
+    int64_t brightness{};
+    for (Cell cell : cells_) {
+      brightness += cell;
+    }
+    return brightness;
+  }
+
+ private:
+  size_t width_;
+  std::vector<Cell> cells_;
+};
+
+template <typename Cell>
+Answer replay(const std::vector<Instruction>& instructions, size_t width,
+              Band& band) {
+  auto start{std::chrono::steady_clock::now()};
+  LightGrid lights{width, band.rows};
+  BrightnessPlane<Cell> brightness{width, band.rows};
+
+  {
+    AOC_SCOPED_TIMER("day06.replay");
+    AOC_ALLOCATION_FREE("day06.replay");
+
+    size_t last_row{band.first_row + band.rows - 1};
+    for (const Instruction& instruction : instructions) {
+      if (instruction.y_2 < band.first_row || instruction.y_1 > last_row) {
+        continue;
+      }
+
+      // the part of the instruction inside the band, in band rows
+      Instruction clipped{instruction};
+      clipped.y_1 = std::max(instruction.y_1, band.first_row) - band.first_row;
+      clipped.y_2 = std::min(instruction.y_2, last_row) - band.first_row;
+
+      uint64_t cells{(clipped.x_2 - clipped.x_1 + 1) *
+                     (clipped.y_2 - clipped.y_1 + 1)};
+      AOC_COUNT("day06.replay.cells", cells);
+      band.cells += cells;
+
+      lights.apply(clipped);
+      brightness.apply(clipped);
+    }
+  }
+
+  Answer answer{static_cast<long>(lights.count()), brightness.total()};
+  band.time = std::chrono::steady_clock::now() - start;
+  return answer;
+}
+
+Answer dense(const std::vector<Instruction>& instructions, size_t width,
+             size_t height, size_t threads, std::vector<Band>* bands) {
+  AOC_COUNT("day06.replay.instructions", instructions.size());
+  AOC_RATIO("day06.replay.cells_per_instruction", "day06.replay.cells",
+            "day06.replay.instructions");
+
+  // no band is ever empty, so every band advances `first` below
+  threads = std::clamp<size_t>(threads, 1, std::max<size_t>(height, 1));
+  size_t band_rows{(height + threads - 1) / threads};
+  std::vector<Band> parts{};
+  for (size_t first{}; first < height; first += band_rows) {
+    parts.push_back(Band{first, std::min(band_rows, height - first), 0, {}});
+  }
+
+  std::vector<Answer> answers(parts.size());
+  auto run{[&instructions, width, &parts, &answers](size_t i) {
+    // every instruction adds at most 2 to a light
+    answers[i] = instructions.size() <= UINT16_MAX / 2
+                     ? replay<uint16_t>(instructions, width, parts[i])
+                     : replay<uint32_t>(instructions, width, parts[i]);
+  }};
+
+  if (parts.size() == 1) {
+    run(0);
+  } else {
+    aoc::ThreadPool pool{threads};
+    for (size_t i{}; i < parts.size(); ++i) {
+      pool.submit([&run, i] { run(i); });
+    }
+    pool.wait();
+  }
+
+  Answer answer{};
+  for (const Answer& part : answers) {
+    answer.count += part.count;
+    answer.brightness += part.brightness;
+  }
+  if (bands != nullptr) {
+    *bands = std::move(parts);
+  }
+  return answer;
+}
+
+// the sorted, distinct coordinates where rectangles start or end along one
+// axis; band i covers [breaks[i], breaks[i + 1])
+std::vector<size_t> breakpoints(const std::vector<Instruction>& instructions,
+                                size_t Instruction::*low,
+                                size_t Instruction::*high) {
+  std::vector<size_t> breaks{};
+  breaks.reserve(2 * instructions.size());
+  for (const Instruction& instruction : instructions) {
+    breaks.push_back(instruction.*low);
+    breaks.push_back(instruction.*high + 1);
+  }
+  std::sort(breaks.begin(), breaks.end());
+  breaks.erase(std::unique(breaks.begin(), breaks.end()), breaks.end());
+  return breaks;
+}
+
+size_t band_of(const std::vector<size_t>& breaks, size_t coordinate) {
+  return static_cast<size_t>(
+      std::lower_bound(breaks.begin(), breaks.end(), coordinate) -
+      breaks.begin());
+}
+
+// an instruction in band indices: columns [x_1, x_2), rows [y_1, y_2)
+struct Span {
+  Action action;
+  size_t x_1, x_2;
+  size_t y_1, y_2;
+};
+
+Answer sweep(const std::vector<Instruction>& instructions,
+             const std::vector<size_t>& xs, const std::vector<size_t>& ys) {
+  std::vector<Span> spans{};
+  spans.reserve(instructions.size());
+  for (const auto& [action, x_1, y_1, x_2, y_2] : instructions) {
+    spans.push_back(Span{action, band_of(xs, x_1), band_of(xs, x_2 + 1),
+                         band_of(ys, y_1), band_of(ys, y_2 + 1)});
+  }
+
+  // instructions by the column band they start and stop covering
+  std::vector<std::vector<size_t>> starts(xs.size());
+  std::vector<std::vector<size_t>> stops(xs.size());
+  for (size_t i{}; i < spans.size(); ++i) {
+    starts[spans[i].x_1].push_back(i);
+    stops[spans[i].x_2].push_back(i);
+  }
+
+  // which instructions cover the current column band, as a bitset so they
+  // come out in input order
+  std::vector<uint64_t> active((spans.size() + 63) / 64);
+  // one column band of compressed cells
+  size_t rows{ys.size() - 1};
+  std::vector<uint8_t> lit(rows);
+  std::vector<uint64_t> brightness(rows);
+
+  AOC_SCOPED_TIMER("day06.sweep");
+  AOC_ALLOCATION_FREE("day06.sweep");
+  AOC_COUNT("day06.sweep.bands", xs.size() - 1);
+
+  Answer answer{};
+  for (size_t band{}; band + 1 < xs.size(); ++band) {
+    for (size_t i : stops[band]) {
+      active[i / 64] &= ~(uint64_t{1} << (i % 64));
+    }
+    for (size_t i : starts[band]) {
+      active[i / 64] |= uint64_t{1} << (i % 64);
+    }
+
+    std::fill(lit.begin(), lit.end(), 0);
+    std::fill(brightness.begin(), brightness.end(), 0);
+    for (size_t w{}; w < active.size(); ++w) {
+      for (uint64_t bits{active[w]}; bits != 0; bits &= bits - 1) {
+        const Span& span{spans[w * 64 + static_cast<size_t>(
+                                           std::countr_zero(bits))]};
+        AOC_COUNT("day06.sweep.cells", span.y_2 - span.y_1);
+
+        uint8_t* cells{lit.data() + span.y_1};
+        size_t size{span.y_2 - span.y_1};
+        switch (span.action) {
+          case Action::TURN_ON:
+            std::fill_n(cells, size, 1);
+            break;
+          case Action::TURN_OFF:
+            std::fill_n(cells, size, 0);
+            break;
+          case Action::TOGGLE:
+            for (size_t j{}; j < size; ++j) {
+              cells[j] ^= 1;
+            }
+            break;
+        }
+        brighten_scalar(brightness.data() + span.y_1, size, span.action);
+      }
+    }
+
+    // every compressed cell stands for a whole rectangle of lights
+    uint64_t band_lit{};
+    uint64_t band_brightness{};
+    for (size_t j{}; j < rows; ++j) {
+      uint64_t height{ys[j + 1] - ys[j]};
+      band_lit += lit[j] * height;
+      band_brightness += brightness[j] * height;
+    }
+    uint64_t width{xs[band + 1] - xs[band]};
+    answer.count += static_cast<long>(band_lit * width);
+    answer.brightness += static_cast<int64_t>(band_brightness * width);
+  }
+  return answer;
+}
+
+}  // namespace
+
+std::vector<Instruction> parse(std::string_view buffer) {
+  std::vector<Instruction> instructions{};
+
+  size_t pos{};
+  while (pos < buffer.size()) {
+    size_t end{buffer.find('\n', pos)};
+    if (end == std::string_view::npos) {
+      end = buffer.size();
+    }
+
+    std::string_view line{buffer.data() + pos, end - pos};
+
+    Instruction instruction{};
+    auto& [action, x_1, y_1, x_2, y_2] = instruction;
+
+    // parse line for action and coordinate range
+    if (aoc::scan<"turn on {},{} through {},{}">(line, x_1, y_1, x_2, y_2)) {
+      action = Action::TURN_ON;
+    } else if (aoc::scan<"turn off {},{} through {},{}">(line, x_1, y_1, x_2,
+                                                          y_2)) {
+      action = Action::TURN_OFF;
+    } else if (aoc::scan<"toggle {},{} through {},{}">(line, x_1, y_1, x_2,
+                                                        y_2)) {
+      action = Action::TOGGLE;
+    } else {
+      throw std::runtime_error("invalid instruction format\n");
+    }
+    if (x_1 > x_2 || y_1 > y_2) {
+      throw std::runtime_error("instruction range runs backwards\n");
+    }
+
+    instructions.push_back(instruction);
+
+    pos = end + 1;
+  }
+
+  return instructions;
+}
+
+void use_engine(Engine engine) { selected_engine = engine; }
+
+std::string_view engine_name(Engine engine) {
+  switch (engine) {
+    case Engine::DENSE:
+      return "dense";
+    case Engine::SWEEP:
+      return "sweep";
+    default:
+      return "auto";
+  }
+}
+
+Answer solve(const std::vector<Instruction>& instructions) {
+  return solve_parallel(instructions, 1);
+}
+
+Answer solve_parallel(const std::vector<Instruction>& instructions,
+                      size_t threads, std::vector<Band>* bands) {
+  if (instructions.empty()) {
+    return Answer{};
+  }
+
+  size_t width{};
+  size_t height{};
+  for (const Instruction& instruction : instructions) {
+    width = std::max(width, instruction.x_2 + 1);
+    height = std::max(height, instruction.y_2 + 1);
+  }
+
+  std::vector<size_t> xs{breakpoints(instructions, &Instruction::x_1,
+                                     &Instruction::x_2)};
+  std::vector<size_t> ys{breakpoints(instructions, &Instruction::y_1,
+                                     &Instruction::y_2)};
+
+  Engine engine{selected_engine};
+  if (engine == Engine::AUTO) {
+    // both engines visit their cells once per covering instruction, so
+    // compare grid sizes; in floating point, as a huge grid's area overflows
+    double lights{static_cast<double>(width) * static_cast<double>(height)};
+    double compressed{static_cast<double>(xs.size() - 1) *
+                      static_cast<double>(ys.size() - 1)};
+    bool fits{lights <= MAX_DENSE_LIGHTS};
+    bool sparse{compressed * DENSE_ADVANTAGE < lights};
+    engine = fits && !sparse ? Engine::DENSE : Engine::SWEEP;
+  }
+
+  if (engine == Engine::SWEEP) {
+    AOC_COUNT("day06.engine.sweep", 1);
+    return sweep(instructions, xs, ys);
+  }
+
+  AOC_COUNT("day06.engine.dense", 1);
+  return dense(instructions, width, height, threads, bands);
+}
+
+void print_bands(std::ostream& out, const std::vector<Band>& bands) {
+  if (bands.empty()) {
+    return;
+  }
+
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+  Milliseconds slowest{};
+  Milliseconds total{};
+  out << "-- bands --\n" << std::fixed << std::setprecision(3);
+  for (const Band& band : bands) {
+    Milliseconds time{band.time};
+    slowest = std::max(slowest, time);
+    total += time;
+    out << "rows " << std::setw(7) << band.first_row << " - " << std::left
+        << std::setw(7) << band.first_row + band.rows - 1 << std::right
+        << std::setw(12) << time.count() << " ms" << std::setw(16)
+        << band.cells << " cells\n";
+  }
+  // 1.0 when every band took as long as the others
+  out << "imbalance (slowest / mean)  "
+      << slowest / (total / static_cast<double>(bands.size())) << '\n';
+}
+
+void print(std::ostream& out, const Answer& answer) {
+  out << answer.count << " lights are lit\n";
+  out << "the total brightness is " << answer.brightness << '\n';
+}
+
+}  // namespace aoc2015::day06
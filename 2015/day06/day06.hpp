@@ -0,0 +1,52 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+namespace aoc2015::day06 {
+
+enum class Action { TURN_ON, TURN_OFF, TOGGLE };
+
+struct Instruction {
+  Action action;
+  size_t x_1, y_1;
+  size_t x_2, y_2;
+};
+
+struct Answer {
+  long count;
+  int64_t brightness;
+};
+
+// replay engines: a dense grid of every light, or a sweep over the bands
+// between rectangle edges; AUTO picks one from the grid's size
+enum class Engine { AUTO, DENSE, SWEEP };
+
+void use_engine(Engine engine);
+std::string_view engine_name(Engine engine);
+
+// rows one thread replayed in `solve_parallel`, and what it cost
+struct Band {
+  size_t first_row;
+  size_t rows;
+  uint64_t cells;  // lights updated, over every instruction
+  std::chrono::nanoseconds time;
+};
+
+std::vector<Instruction> parse(std::string_view buffer);
+Answer solve(const std::vector<Instruction>& instructions);
+
+// `solve` with the dense grid cut into `threads` bands of rows, each
+// replaying every instruction clipped to its rows on its own thread; the
+// bands are stored in `bands` if given (the sweep engine runs serially and
+// leaves it empty)
+Answer solve_parallel(const std::vector<Instruction>& instructions,
+                      size_t threads, std::vector<Band>* bands = nullptr);
+void print_bands(std::ostream& out, const std::vector<Band>& bands);
+void print(std::ostream& out, const Answer& answer);
+
+}  // namespace aoc2015::day06
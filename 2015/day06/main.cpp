@@ -1,41 +1,14 @@
 #include <algorithm>
-#include <cstdio>
-#include <fstream>
+#include <array>
+#include <cstddef>
 #include <iostream>
-#include <ranges>
-#include <string>
+#include <optional>
 #include <vector>
 
-/*
-    Advent of Code 2015 – Day 6
-
-    Problem:
-        Read in instructions to turn on, turn off, or toggle light in a
-   1000x1000 grid.
-
-        Part 1: Count lights that are on
-        Part 2: Sum and track brightness levels
-
-    Approach:
-        Read entire input file into buffer and parse into `std::string_view`
-
-        Use 2D vector (1000x1000) to represent grid state
-        - Part 1: `std::vector<std::vector<bool>>` for on/off state
-        - Part 2: `std::vector<std::vector<int>>` for brightness levels
-
-        Parse each instruction using `std::sscanf` to extract:
-        - Action type (turn on, turn off, toggle)
-        - Coordinate ranges (x1,y1 through x2,y2)
-
-        Iterate through the specified rectangular regions and apply instructions
-
-        Count result using `std::ranges::count` with flattened view
-        Iterate and sum brightness levels across all lights
-
-    Complexity:
-        O(n*a) time -- where n is number of instructions, a is average area per
-   instruction O(1) space
-*/
+#include "../../common/args.hpp"
+#include "../../common/input.hpp"
+#include "../../common/metrics.hpp"
+#include "day06.hpp"
 
 int main(int argc, char* argv[]) {
   if (argc < 2) {
@@ -43,72 +16,43 @@ int main(int argc, char* argv[]) {
     return -1;
   }
 
-  std::ifstream file{argv[1], std::ios::ate};
-  if (!file.is_open()) {
-    throw std::runtime_error("could not open input file");
-  }
-
-  std::string buffer(file.tellg(), '\0');
-  file.seekg(0);
-  file.read(buffer.data(), buffer.size());
-
-  std::vector<std::vector<int>> grid(
-      1000, std::vector<int>(1000, 0));  // 1000 x 1000 elements, all zeros
-
-  size_t pos{};
-  while (pos < buffer.size()) {
-    size_t end{buffer.find('\n', pos)};
-    if (end == std::string::npos) {
-      end = buffer.size();
-    }
-
-    std::string_view line{buffer.data() + pos, end - pos};
-
-    size_t x_1{}, y_1{};
-    size_t x_2{}, y_2{};
-
-    bool turn_on{}, turn_off{}, toggle{};
-
-    // parse line for action and coordinate range
-    if (std::sscanf(line.data(), "turn on %d,%d through %d,%d", &x_1, &y_1,
-                    &x_2, &y_2) == 4) {
-      turn_on = true;
-    } else if (std::sscanf(line.data(), "turn off %d,%d through %d,%d", &x_1,
-                           &y_1, &x_2, &y_2) == 4) {
-      turn_off = true;
-    } else if (std::sscanf(line.data(), "toggle %d,%d through %d,%d", &x_1,
-                           &y_1, &x_2, &y_2) == 4) {
-      toggle = true;
+  namespace day = aoc2015::day06;
+
+  if (const char* name{aoc::option_value(argc, argv, "--engine")}) {
+    constexpr std::array ENGINES{day::Engine::AUTO, day::Engine::DENSE,
+                                 day::Engine::SWEEP};
+    auto engine{std::ranges::find_if(ENGINES, [name](day::Engine e) {
+      return day::engine_name(e) == name;
+    })};
+    if (engine == ENGINES.end()) {
+      std::cerr << name << ": unknown engine (auto, dense or sweep)\n";
+      return -1;
     }
+    day::use_engine(*engine);
+  }
 
-    for (size_t y{y_1}; y <= y_2; ++y) {
-      auto& row{grid[y]};
-      for (size_t x{x_1}; x <= x_2; ++x) {
-        if (turn_on) {
-          ++row[x];
-        } else if (turn_off && row[x] > 0) {
-          --row[x];
-        } else if (toggle) {
-          row[x] += 2;
-        }
-      }
+  std::optional<size_t> threads{};
+  if (const char* value{aoc::option_value(argc, argv, "--threads")}) {
+    threads = aoc::positive_count(value);
+    if (!threads.has_value()) {
+      std::cerr << value << ": --threads needs a count of at least 1\n";
+      return -1;
     }
-
-    pos = end + 1;
   }
 
-  auto count{std::ranges::count_if(grid | std::ranges::views::join,
-                                   [](int lit) { return lit > 0; })};
-
-  int brightness{};
-  for (const auto& row : grid) {
-    for (const auto& value : row) {
-      brightness += value;
-    }
+  const aoc::Input input{argv[1]};
+  std::vector<day::Band> bands{};
+  if (threads.has_value()) {
+    day::print(std::cout,
+               day::solve_parallel(day::parse(input.view()), *threads, &bands));
+  } else {
+    day::print(std::cout, day::solve(day::parse(input.view())));
   }
 
-  std::cout << count << " lights are lit\n";
-  std::cout << "the total brightness is " << brightness << '\n';
+  if (aoc::metrics::stats_requested(argc, argv)) {
+    day::print_bands(std::cerr, bands);
+    aoc::metrics::report(std::cerr);
+  }
 
   return 0;
-}
\ No newline at end of file
+}
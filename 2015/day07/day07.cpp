@@ -0,0 +1,513 @@
+#include "day07.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../../common/alloc.hpp"
+#include "../../common/metrics.hpp"
+#include "../../common/scan.hpp"
+
+/*
+    Advent of Code 2015 – Day 7
+
+    Problem:
+        Simulate a circuit of bitwise logic gates where wires carry 16-bit
+   signals.
+
+    Approach:
+        Map entire input file and parse through a `std::string_view`
+
+        Parse each instruction using `aoc::scan` to extract:
+            - Operation type
+            - Input operands (wire names or numeric literals)
+            - Output wire name
+
+        Compile the gates while parsing:
+            - Intern every wire name, and every literal, to a dense slot id
+   through a flat open-addressing table; literals are decoded once and preset
+   in the initial signal array
+            - Order the gates topologically (Kahn's algorithm over the wires
+   each gate reads), rejecting undriven wires and cycles
+            - Renumber the wires in that order and emit a flat array of
+   fixed-size ops, so op i writes slot i and the common chain of gates reads
+   the slot just written
+
+        Evaluation is then one linear pass over the ops, reading and writing
+   signals by slot: no hashing, no string compares and no recursion, so
+   circuits of any depth are fine
+
+        Part 2 overrides b with part 1's answer. The ops before b's own gate
+   do not read b, so their signals stay valid and only the ops after it are
+   run again
+
+        For what-if runs (`--override b=1,c=2` applies each in turn), a
+   `Simulator` lists the gates reading each wire once, then answers every
+   override by re-evaluating only the gates in its downstream cone: dirty
+   gates sit in a bitset taken lowest first, i.e. in circuit order, and a
+   gate whose signal does not change marks none of its readers
+
+    Complexity:
+        O(n) time -- where n is number of gates, compiled and evaluated once
+        O(n) space -- ops, signals and names for all wires
+*/
+
+namespace aoc2015::day07 {
+
+namespace {
+
+constexpr uint32_t NO_GATE{UINT32_MAX};
+
+// a parsed gate, before it is ordered
+struct Gate {
+  uint32_t output;
+  Op op;
+};
+
+bool binary(Operation operation) {
+  return operation == Operation::AND || operation == Operation::OR;
+}
+
+// collects the gates as they are parsed and orders them into a `Circuit`
+class Compiler {
+ public:
+  explicit Compiler(size_t expected_gates)
+      : table_(std::bit_ceil(std::max<size_t>(2 * expected_gates, 64))),
+        shift_{64 - std::countr_zero(table_.size())} {
+    names_.reserve(expected_gates);
+    signals_.reserve(expected_gates);
+    gate_of_.reserve(expected_gates);
+    gates_.reserve(expected_gates);
+  }
+
+  // slot of a wire name or a literal, interned on first use
+  uint32_t operand(std::string_view token) {
+    uint64_t hash{std::hash<std::string_view>{}(token)};
+    Entry& entry{table_[find(token, hash)]};
+    if (entry.id != NO_WIRE) {
+      return entry.id;
+    }
+
+    uint16_t value{};
+    bool literal{token.front() >= '0' && token.front() <= '9'};
+    if (literal) {
+      uint32_t decoded{};
+      auto [ptr, ec]{std::from_chars(token.data(),
+                                     token.data() + token.size(), decoded)};
+      if (ec != std::errc{} || ptr != token.data() + token.size()) {
+        throw std::runtime_error("invalid signal literal\n");
+      }
+      if (decoded > UINT16_MAX) {
+        throw std::runtime_error("signal literal out of range\n");
+      }
+      value = static_cast<uint16_t>(decoded);
+    }
+
+    uint32_t id{static_cast<uint32_t>(names_.size())};
+    entry = Entry{static_cast<uint32_t>(hash), id};
+    names_.emplace_back(token);
+    signals_.push_back(value);
+    literal_.push_back(literal);
+    gate_of_.push_back(NO_GATE);
+    if (names_.size() * 2 > table_.size()) {
+      grow();
+    }
+    return id;
+  }
+
+  // a later gate for the same wire replaces the earlier one
+  void drive(std::string_view wire, Op op) {
+    uint32_t output{operand(wire)};
+    if (literal_[output]) {
+      throw std::runtime_error("cannot drive a literal\n");
+    }
+    if (gate_of_[output] != NO_GATE) {
+      gates_[gate_of_[output]].op = op;
+      return;
+    }
+    gate_of_[output] = static_cast<uint32_t>(gates_.size());
+    gates_.push_back(Gate{output, op});
+  }
+
+  Circuit compile() {
+    size_t slots{names_.size()};
+
+    // gates reading each wire, as offsets into `readers`
+    std::vector<uint32_t> pending(gates_.size());
+    std::vector<uint32_t> offsets(slots + 1);
+    for (uint32_t gate{}; gate < gates_.size(); ++gate) {
+      for_each_input(gates_[gate].op, [&](uint32_t wire) {
+        ++offsets[wire + 1];
+        ++pending[gate];
+      });
+    }
+    for (size_t slot{}; slot < slots; ++slot) {
+      offsets[slot + 1] += offsets[slot];
+    }
+    std::vector<uint32_t> readers(offsets.back());
+    std::vector<uint32_t> fill{offsets.begin(), offsets.end() - 1};
+    for (uint32_t gate{}; gate < gates_.size(); ++gate) {
+      for_each_input(gates_[gate].op,
+                     [&](uint32_t wire) { readers[fill[wire]++] = gate; });
+    }
+
+    // Kahn's algorithm: `order` doubles as the queue of ready gates
+    std::vector<uint32_t> order{};
+    order.reserve(gates_.size());
+    for (uint32_t gate{}; gate < gates_.size(); ++gate) {
+      if (pending[gate] == 0) {
+        order.push_back(gate);
+      }
+    }
+    for (size_t head{}; head < order.size(); ++head) {
+      uint32_t wire{gates_[order[head]].output};
+      for (uint32_t i{offsets[wire]}; i < offsets[wire + 1]; ++i) {
+        if (--pending[readers[i]] == 0) {
+          order.push_back(readers[i]);
+        }
+      }
+    }
+    if (order.size() != gates_.size()) {
+      throw std::runtime_error("circuit contains a cycle\n");
+    }
+
+    // renumber the slots: wires in evaluation order, so each op writes the
+    // slot after the previous op's, then the literals. Gates only read
+    // driven wires (or the reads above would have thrown), so a wire nothing
+    // drives was read by a gate that was replaced later, and is dropped
+    std::vector<uint32_t> slot_of(slots, NO_WIRE);
+    for (uint32_t i{}; i < order.size(); ++i) {
+      slot_of[gates_[order[i]].output] = i;
+    }
+    uint32_t next{static_cast<uint32_t>(order.size())};
+    for (size_t slot{}; slot < slots; ++slot) {
+      if (literal_[slot]) {
+        slot_of[slot] = next++;
+      }
+    }
+
+    uint32_t a{driven("a")};
+    if (a == NO_WIRE) {
+      throw std::runtime_error("circuit does not drive wire a\n");
+    }
+    uint32_t b{driven("b")};
+
+    Circuit circuit{};
+    circuit.ops.reserve(order.size());
+    for (uint32_t gate : order) {
+      Op op{gates_[gate].op};
+      op.lhs = slot_of[op.lhs];
+      op.rhs = op.rhs == NO_WIRE ? NO_WIRE : slot_of[op.rhs];
+      circuit.ops.push_back(op);
+    }
+    circuit.signals.resize(next);
+    circuit.names.resize(next);
+    for (size_t slot{}; slot < slots; ++slot) {
+      if (slot_of[slot] == NO_WIRE) {
+        continue;
+      }
+      circuit.signals[slot_of[slot]] = signals_[slot];
+      circuit.names[slot_of[slot]] = std::move(names_[slot]);
+    }
+
+    circuit.a = slot_of[a];
+    circuit.b = b == NO_WIRE ? NO_WIRE : slot_of[b];
+    return circuit;
+  }
+
+ private:
+  // calls `visit` with every wire (not literal) slot the gate reads
+  template <typename Visit>
+  void for_each_input(const Op& op, Visit visit) const {
+    for (uint32_t slot : {op.lhs, binary(op.operation) ? op.rhs : NO_WIRE}) {
+      if (slot == NO_WIRE || literal_[slot]) {
+        continue;
+      }
+      if (gate_of_[slot] == NO_GATE) {
+        throw std::runtime_error("wire " + names_[slot] +
+                                 " is read but never driven\n");
+      }
+      visit(slot);
+    }
+  }
+
+  // open addressing over the slot ids, with the low half of each name's
+  // hash kept alongside so that most probes never touch `names_`
+  struct Entry {
+    uint32_t tag{};
+    uint32_t id{NO_WIRE};
+  };
+
+  // index of the entry holding `name`, or of the empty entry it would take
+  size_t find(std::string_view name, uint64_t hash) const {
+    auto tag{static_cast<uint32_t>(hash)};
+    for (size_t i{index(hash)};; i = (i + 1) & (table_.size() - 1)) {
+      const Entry& entry{table_[i]};
+      if (entry.id == NO_WIRE ||
+          (entry.tag == tag && names_[entry.id] == name)) {
+        return i;
+      }
+    }
+  }
+
+  size_t index(uint64_t hash) const {
+    // Fibonacci hashing: the top bits of the product index the table
+    return static_cast<size_t>((hash * 0x9e3779b97f4a7c15) >> shift_);
+  }
+
+  void grow() {
+    std::vector<Entry> old(table_.size() * 2);
+    old.swap(table_);
+    --shift_;
+    for (const Entry& entry : old) {
+      if (entry.id != NO_WIRE) {
+        uint64_t hash{std::hash<std::string_view>{}(names_[entry.id])};
+        table_[find(names_[entry.id], hash)] = entry;
+      }
+    }
+  }
+
+  uint32_t driven(std::string_view name) const {
+    const Entry& entry{
+        table_[find(name, std::hash<std::string_view>{}(name))]};
+    if (entry.id == NO_WIRE || gate_of_[entry.id] == NO_GATE) {
+      return NO_WIRE;
+    }
+    return entry.id;
+  }
+
+  std::vector<Entry> table_;
+  int shift_;
+  std::vector<std::string> names_{};
+  std::vector<uint16_t> signals_{};
+  std::vector<bool> literal_{};
+  std::vector<uint32_t> gate_of_{};
+  std::vector<Gate> gates_{};
+};
+
+uint8_t shift_amount(int shift) {
+  if (shift < 0 || shift > 15) {
+    throw std::runtime_error("shift out of range\n");
+  }
+  return static_cast<uint8_t>(shift);
+}
+
+uint16_t apply(const Op& op, const uint16_t* signals) {
+  uint16_t lhs{signals[op.lhs]};
+  switch (op.operation) {
+    case Operation::ASSIGN:
+      return lhs;
+    case Operation::NOT:
+      return static_cast<uint16_t>(~lhs);
+    case Operation::AND:
+      return lhs & signals[op.rhs];
+    case Operation::OR:
+      return lhs | signals[op.rhs];
+    case Operation::LSHIFT:
+      return static_cast<uint16_t>(lhs << op.shift);
+    case Operation::RSHIFT:
+      return static_cast<uint16_t>(lhs >> op.shift);
+  }
+  return 0;
+}
+
+// runs `ops`, the ones driving the slots from `first` on
+void evaluate(std::span<const Op> ops, uint32_t first, uint16_t* signals) {
+  AOC_COUNT("day07.evaluate.ops", ops.size());
+
+  for (size_t i{}; i < ops.size(); ++i) {
+    signals[first + i] = apply(ops[i], signals);
+  }
+}
+
+}  // namespace
+
+Circuit parse(std::string_view buffer) {
+  // the shortest gate, "1 -> a", is seven bytes with its newline, but most
+  // are a good deal longer
+  Compiler compiler{buffer.size() / 16};
+
+  size_t pos{};
+  while (pos < buffer.size()) {
+    size_t end{buffer.find('\n', pos)};
+    if (end == std::string_view::npos) {
+      end = buffer.size();
+    }
+
+    std::string_view line{buffer.data() + pos, end - pos};
+    pos = end + 1;
+    if (line.empty()) {
+      continue;
+    }
+
+    std::string_view output{}, lhs{}, rhs{};
+    int shift{};
+
+    if (aoc::scan<"{} -> {}">(line, lhs, output)) {
+      // ASSIGN
+      compiler.drive(output,
+                     Op{compiler.operand(lhs), NO_WIRE, Operation::ASSIGN, 0});
+
+    } else if (aoc::scan<"NOT {} -> {}">(line, lhs, output)) {
+      // NOT
+      compiler.drive(output,
+                     Op{compiler.operand(lhs), NO_WIRE, Operation::NOT, 0});
+
+    } else if (aoc::scan<"{} AND {} -> {}">(line, lhs, rhs, output)) {
+      // AND
+      compiler.drive(output, Op{compiler.operand(lhs),
+                                compiler.operand(rhs), Operation::AND, 0});
+
+    } else if (aoc::scan<"{} OR {} -> {}">(line, lhs, rhs, output)) {
+      // OR
+      compiler.drive(output, Op{compiler.operand(lhs),
+                                compiler.operand(rhs), Operation::OR, 0});
+
+    } else if (aoc::scan<"{} LSHIFT {} -> {}">(line, lhs, shift, output)) {
+      // LSHIFT
+      compiler.drive(output, Op{compiler.operand(lhs), NO_WIRE,
+                                Operation::LSHIFT, shift_amount(shift)});
+
+    } else if (aoc::scan<"{} RSHIFT {} -> {}">(line, lhs, shift, output)) {
+      // RSHIFT
+      compiler.drive(output, Op{compiler.operand(lhs), NO_WIRE,
+                                Operation::RSHIFT, shift_amount(shift)});
+
+    } else {
+      throw std::runtime_error("invalid instruction\n");
+    }
+  }
+
+  return compiler.compile();
+}
+
+Answer solve(const Circuit& circuit) {
+  AOC_SCOPED_TIMER("day07.evaluate");
+
+  std::vector<uint16_t> signals{circuit.signals};
+  AOC_ALLOCATION_FREE("day07.evaluate");
+
+  evaluate(circuit.ops, 0, signals.data());
+  uint16_t a_signal1{signals[circuit.a]};
+
+  if (circuit.b != NO_WIRE) {
+    signals[circuit.b] = a_signal1;
+    evaluate(std::span{circuit.ops}.subspan(circuit.b + 1), circuit.b + 1,
+             signals.data());
+  }
+  uint16_t a_signal2{signals[circuit.a]};
+
+  return Answer{a_signal1, a_signal2};
+}
+
+Simulator::Simulator(const Circuit& circuit)
+    : circuit_{circuit},
+      signals_{circuit.signals},
+      reader_offsets_(circuit.ops.size() + 1),
+      dirty_((circuit.ops.size() + 63) / 64),
+      held_(circuit.ops.size()) {
+  evaluate(circuit.ops, 0, signals_.data());
+
+  // wires are the slots below ops.size(); the rest are literals
+  auto inputs{[&circuit](const Op& op) {
+    auto wires{circuit.ops.size()};
+    return std::array<uint32_t, 2>{
+        op.lhs < wires ? op.lhs : NO_WIRE,
+        binary(op.operation) && op.rhs < wires ? op.rhs : NO_WIRE};
+  }};
+  for (const Op& op : circuit.ops) {
+    for (uint32_t wire : inputs(op)) {
+      if (wire != NO_WIRE) {
+        ++reader_offsets_[wire + 1];
+      }
+    }
+  }
+  for (size_t wire{}; wire < circuit.ops.size(); ++wire) {
+    reader_offsets_[wire + 1] += reader_offsets_[wire];
+  }
+  readers_.resize(reader_offsets_.back());
+  std::vector<uint32_t> fill{reader_offsets_.begin(),
+                             reader_offsets_.end() - 1};
+  for (uint32_t i{}; i < circuit.ops.size(); ++i) {
+    for (uint32_t wire : inputs(circuit.ops[i])) {
+      if (wire != NO_WIRE) {
+        readers_[fill[wire]++] = i;
+      }
+    }
+  }
+}
+
+uint32_t Simulator::wire(std::string_view name) const {
+  for (uint32_t wire{}; wire < circuit_.ops.size(); ++wire) {
+    if (circuit_.names[wire] == name) {
+      return wire;
+    }
+  }
+  throw std::runtime_error("circuit has no wire " + std::string(name) +
+                           "\n");
+}
+
+size_t Simulator::override_wire(uint32_t wire, uint16_t value) {
+  AOC_SCOPED_TIMER("day07.override");
+  AOC_ALLOCATION_FREE("day07.override");
+
+  held_[wire] = true;
+  if (signals_[wire] == value) {
+    return 0;
+  }
+  signals_[wire] = value;
+  mark_readers(wire);
+
+  // op i drives slot i and reads only lower slots, so taking dirty ops
+  // lowest first re-evaluates each one once, after all of its inputs
+  size_t evaluated{};
+  for (size_t word{wire / 64}; pending_ > 0; ++word) {
+    while (dirty_[word] != 0) {
+      auto op{static_cast<uint32_t>(word * 64 +
+                                    std::countr_zero(dirty_[word]))};
+      dirty_[word] &= dirty_[word] - 1;
+      --pending_;
+      ++evaluated;
+
+      uint16_t result{apply(circuit_.ops[op], signals_.data())};
+      if (result != signals_[op]) {
+        signals_[op] = result;
+        mark_readers(op);
+      }
+    }
+  }
+
+  AOC_COUNT("day07.override.evaluations", evaluated);
+  return evaluated;
+}
+
+void Simulator::mark_readers(uint32_t wire) {
+  for (uint32_t i{reader_offsets_[wire]}; i < reader_offsets_[wire + 1];
+       ++i) {
+    uint32_t op{readers_[i]};
+    uint64_t bit{uint64_t{1} << (op % 64)};
+    if (!held_[op] && (dirty_[op / 64] & bit) == 0) {
+      dirty_[op / 64] |= bit;
+      ++pending_;
+    }
+  }
+}
+
+void print(std::ostream& out, const Answer& answer) {
+  out << "Part 1: the signal provided to wire a is " << answer.a_signal1
+      << '\n';
+  out << "Part 2: the signal provided to wire a is " << answer.a_signal2
+      << '\n';
+}
+
+}  // namespace aoc2015::day07
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aoc2015::day07 {
+
+enum class Operation : uint8_t { ASSIGN, NOT, AND, OR, LSHIFT, RSHIFT };
+
+constexpr uint32_t NO_WIRE{UINT32_MAX};
+
+// one gate, with its operands as slots of the signal array; a slot holds a
+// wire or a literal that was decoded while compiling
+struct Op {
+  uint32_t lhs;
+  uint32_t rhs;  // only read by AND and OR
+  Operation operation;
+  uint8_t shift;
+};
+
+// gates ordered so that each one comes after the gates driving its inputs,
+// which makes evaluation a single pass over `ops`; wires are numbered in the
+// same order, so op i drives signal slot i and literal slots follow the wires
+struct Circuit {
+  std::vector<Op> ops;
+  std::vector<uint16_t> signals;   // initial values: literals preset
+  std::vector<std::string> names;  // wire name or literal digits, per slot
+  uint32_t a;
+  uint32_t b;  // NO_WIRE if nothing drives b
+};
+
+struct Answer {
+  uint16_t a_signal1;
+  uint16_t a_signal2;
+};
+
+Circuit parse(std::string_view buffer);
+Answer solve(const Circuit& circuit);
+void print(std::ostream& out, const Answer& answer);
+
+// a circuit kept evaluated across what-if runs that override wires one after
+// another: the gates reading each wire are listed up front, and an override
+// re-evaluates only the gates downstream of it, in circuit order, pruning
+// every branch where a recomputed signal comes out unchanged
+class Simulator {
+ public:
+  explicit Simulator(const Circuit& circuit);
+
+  // slot of the wire called `name`; throws if the circuit has none
+  uint32_t wire(std::string_view name) const;
+  uint16_t signal(uint32_t wire) const { return signals_[wire]; }
+
+  // holds `wire` at `value` from now on, whatever its gate computes, and
+  // returns the number of gates that were re-evaluated
+  size_t override_wire(uint32_t wire, uint16_t value);
+
+ private:
+  void mark_readers(uint32_t wire);
+
+  const Circuit& circuit_;
+  std::vector<uint16_t> signals_;
+  std::vector<uint32_t> reader_offsets_;  // per wire, into `readers_`
+  std::vector<uint32_t> readers_;         // ops reading each wire
+  std::vector<uint64_t> dirty_;           // ops waiting to be re-evaluated
+  std::vector<bool> held_;                // wires fixed by an override
+  size_t pending_{};                      // bits set in `dirty_`
+};
+
+}  // namespace aoc2015::day07
@@ -0,0 +1,111 @@
+#include "day08.hpp"
+
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include "../../common/alloc.hpp"
+
+/*
+    Advent of Code 2015 – Day 8
+
+    Problem:
+        Compute the difference between the number of characters of code and the
+   number of characters in memory, then compute the difference between the
+   encoded length and the original code length.
+
+    Approach:
+        Map entire input file and parse through a `std::string_view`
+
+        Part 1 – Code vs Memory:
+            Accumulate raw line length into total_in_code.
+            Walk char by char between the surrounding quotes:
+                - `\\` or `\"` → advance 2, count 1 memory char
+                - `\x??`       → advance 4, count 1 memory char
+                - otherwise    → advance 1, count 1 memory char
+
+        Part 2 – Encoding:
+            Base encoded length per line = line.size() + 4
+                (+2 for new surrounding quotes, +2 for escaping existing quotes)
+            Walk char by char between the surrounding quotes:
+                - `\\` or `\"` → advance 2, add 2 (both chars need escaping)
+                - `\x??`       → advance 4, add 1 (only the `\` needs escaping)
+
+        Both differences are sums over lines, so with `--stream` each line is
+        folded in as it is read
+
+    Complexity:
+        O(n) time -- where n is total characters
+        O(n) space -- O(1) when streaming
+*/
+
+namespace aoc2015::day08 {
+
+std::vector<std::string_view> parse(std::string_view buffer) {
+  std::vector<std::string_view> lines{};
+
+  size_t pos{};
+  while (pos < buffer.size()) {
+    size_t end{buffer.find('\n', pos)};
+    if (end == std::string_view::npos) {
+      end = buffer.size();
+    }
+
+    lines.emplace_back(buffer.data() + pos, end - pos);
+
+    pos = end + 1;
+  }
+
+  return lines;
+}
+
+Answer solve(const std::vector<std::string_view>& lines) {
+  Answer answer{};
+  AOC_ALLOCATION_FREE("day08.solve");
+  for (std::string_view line : lines) {
+    accumulate(answer, line);
+  }
+  return answer;
+}
+
+void accumulate(Answer& answer, std::string_view line) {
+  int64_t total_in_code{};
+  int64_t total_in_memory{};
+  int64_t total_to_encode{};
+
+  total_in_code += line.size();
+  total_to_encode += line.size() + 4;  // add "" and escape chars
+
+  // bounds skip opening and closing "
+  size_t i{1};
+  while (i < line.size() - 1) {
+    if (line[i] == '\\') {
+      if (line[i + 1] == '\\' || line[i + 1] == '"') {
+        i += 2;
+        total_to_encode += 2;  // add escapes to both
+      } else if (line[i + 1] == 'x') {
+        i += 4;
+        total_to_encode += 1;  // add an escape
+      }
+    } else {
+      ++i;
+    }
+    ++total_in_memory;
+  }
+
+  answer.code_minus_memory += total_in_code - total_in_memory;
+  answer.encoded_minus_code += total_to_encode - total_in_code;
+}
+
+void print(std::ostream& out, const Answer& answer) {
+  out << "Difference between total number of characters in code vs in "
+         "memory:  "
+      << answer.code_minus_memory << '\n';
+
+  out << "Difference between total number of characters to encode the "
+         "string vs in code:  "
+      << answer.encoded_minus_code << '\n';
+}
+
+}  // namespace aoc2015::day08
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+namespace aoc2015::day08 {
+
+struct Answer {
+  int64_t code_minus_memory;
+  int64_t encoded_minus_code;
+};
+
+std::vector<std::string_view> parse(std::string_view buffer);
+Answer solve(const std::vector<std::string_view>& lines);
+
+// streaming form of `solve`: both differences are per-line sums, so each
+// line can be folded in as it is read
+void accumulate(Answer& answer, std::string_view line);
+void print(std::ostream& out, const Answer& answer);
+
+}  // namespace aoc2015::day08
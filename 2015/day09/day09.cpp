@@ -0,0 +1,205 @@
+#include "day09.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <functional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../../common/alloc.hpp"
+#include "../../common/metrics.hpp"
+#include "../../common/scan.hpp"
+
+/*
+    Advent of Code 2015 – Day 9
+
+    Problem:
+        Find the shortest and longest distances for Santa to visit all cities
+        in a Hamiltonian path
+
+    Approach:
+        Map entire input file and parse through a `std::string_view`
+        Use `aoc::scan` to extract city pairs and distances.
+
+        While the number of cities is small, warranting a brute force solution,
+        this approach utilizes Held-Karp algorithm for exploration
+
+        Graph Construction:
+            Parse each line into (from, to, distance) triplets.
+            Map city names to indices for bitmask operations.
+            Build a symmetric adjacency list storing edge weights
+            Construct a adjacency matrix of distances for use in Held-Karp
+            algorithm
+
+        Held-Karp Algorithm:
+            Maintain state of (mask, current) where mask is the set of visited
+            cities and current is the index of the last visited city.
+
+            Base case: all cities visited (mask == (1 << n) - 1) → return 0.
+            Recursive step: for each unvisited city i, recurse with mask | (1 <<
+            i) and take the optimal result via a comparator.
+
+            Memoize results in a 2D table memo[1 << n][n]
+            Run from each city as a starting point and track the best path,
+            reusing the table since a state's result is independent of the
+            starting city
+
+
+        Part 1 – Shortest Path:
+            Run Held-Karp with `init_limit = INT_MAX` and `std::less`
+            comparator.
+
+        Part 2 – Longest Path:
+            Use a separate memo table
+            Run Held-Karp with `init_limit = INT_MIN` and `std::greater`
+            comparator.
+
+    Complexity:
+        O(2^n * n^2) time  -- Held-Karp over n cities
+        O(2^n * n)   space
+*/
+
+namespace aoc2015::day09 {
+
+namespace {
+
+int held_karp(int mask, int current, int n,
+              const std::vector<std::vector<int>>& dist,
+              std::vector<std::vector<int>>& memo, int init_limit,
+              std::function<bool(int, int)> comparator);
+
+}  // namespace
+
+Graph parse(std::string_view buffer) {
+  std::unordered_map<
+      std::string /* city */,
+      std::vector<std::pair<std::string /* city */, int /* distance */>>>
+      adjacency_list{};
+
+  std::unordered_map<std::string, size_t> cities{};
+  size_t index{};
+
+  size_t pos{};
+  while (pos < buffer.size()) {
+    size_t end{buffer.find('\n', pos)};
+    if (end == std::string_view::npos) {
+      end = buffer.size();
+    }
+
+    std::string_view line{buffer.data() + pos, end - pos};
+
+    std::string_view from_sv{}, to_sv{};
+    int distance{};
+    if (!aoc::scan<"{} to {} = {}">(line, from_sv, to_sv, distance)) {
+      throw std::runtime_error("invalid line format\n");
+    }
+
+    std::string from{from_sv};
+    std::string to{to_sv};
+
+    // map city names to integers for use in bitmask
+    if (!cities.contains(from)) {
+      cities[from] = index++;
+    }
+
+    if (!cities.contains(to)) {
+      cities[to] = index++;
+    }
+
+    adjacency_list[from].emplace_back(to, distance);
+    adjacency_list[to].emplace_back(from, distance);
+
+    pos = end + 1;
+  }
+
+  int n{static_cast<int>(cities.size())};
+  std::vector<std::vector<int /* distance */>> dist(
+      n, std::vector<int>(n, INT_MAX));
+
+  // constructs 2D distances vector
+  for (const auto& [from, connections] : adjacency_list) {
+    for (const auto& [to, distance] : connections) {
+      dist[cities.at(from)][cities.at(to)] = distance;
+    }
+  }
+
+  return Graph{n, std::move(dist)};
+}
+
+Answer solve(const Graph& graph) {
+  const auto& [n, dist] = graph;
+
+  // memo[mask][current] does not depend on the starting city, so each
+  // comparator keeps its own table across all starting points
+  std::vector<std::vector<int /* distance */>> shortest_memo(
+      1 << n, std::vector<int>(n, -1));
+  std::vector<std::vector<int /* distance */>> longest_memo(
+      1 << n, std::vector<int>(n, -1));
+
+  AOC_SCOPED_TIMER("day09.held_karp");
+  AOC_ALLOCATION_FREE("day09.held_karp");
+
+  int shortest_distance{INT_MAX};
+  int longest_distance{INT_MIN};
+  for (int curr{}; curr < n; ++curr) {
+    shortest_distance =
+        std::min(shortest_distance,
+                 held_karp(1 << curr, curr, n, dist, shortest_memo, INT_MAX,
+                           std::less<int>{}));
+
+    longest_distance =
+        std::max(longest_distance,
+                 held_karp(1 << curr, curr, n, dist, longest_memo, INT_MIN,
+                           std::greater<int>{}));
+  }
+
+  return Answer{shortest_distance, longest_distance};
+}
+
+void print(std::ostream& out, const Answer& answer) {
+  out << "shortest path is " << answer.shortest << '\n';
+  out << "longest path is " << answer.longest << '\n';
+}
+
+namespace {
+
+int held_karp(int mask, int current, int n,
+              const std::vector<std::vector<int>>& dist,
+              std::vector<std::vector<int>>& memo, int init_limit,
+              std::function<bool(int, int)> comparator) {
+  AOC_COUNT("day09.held_karp.calls", 1);
+
+  if (mask == (1 << n) - 1) {
+    return 0;
+  }
+
+  if (memo[mask][current] != -1) {
+    AOC_COUNT("day09.held_karp.memo_hits", 1);
+    return memo[mask][current];
+  }
+
+  int best{init_limit};
+  for (int i{}; i < n; ++i) {
+    if (!(mask & (1 << i)) && dist[current][i] != init_limit) {
+      int result{
+          held_karp(mask | (1 << i), i, n, dist, memo, init_limit, comparator)};
+
+      if (result != init_limit &&
+          comparator(dist[current][i] + result, best)) {
+        best = dist[current][i] + result;
+      }
+    }
+  }
+
+  memo[mask][current] = best;
+  return best;
+}
+
+}  // namespace
+
+}  // namespace aoc2015::day09
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+namespace aoc2015::day09 {
+
+// adjacency matrix of distances where indices correspond to cities
+struct Graph {
+  int n;
+  std::vector<std::vector<int /* distance */>> dist;
+};
+
+struct Answer {
+  int shortest;
+  int longest;
+};
+
+Graph parse(std::string_view buffer);
+Answer solve(const Graph& graph);
+void print(std::ostream& out, const Answer& answer);
+
+}  // namespace aoc2015::day09
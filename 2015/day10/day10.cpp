@@ -0,0 +1,82 @@
+#include "day10.hpp"
+
+#include <charconv>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "../../common/alloc.hpp"
+#include "../../common/input.hpp"
+
+/*
+ Advent of Code 2015 – Day 10
+
+    Problem:
+        Determine the length of a sequence generated by facross 40 or 50 iterations. 
+
+    Approach:
+        Defines lambda to perform look and say game
+        Ping-pongs between two strings; each round reserves twice the input
+        (a run never grows by more than that) and writes the counts with
+        `std::to_chars`, so the run loop itself never allocates
+        Invokes lambda for the specified number of iterations
+    
+    Complexity:
+        O(n * 2^k) -- where n is the input length and k is the number of iterations
+        O(2^k) -- where k is the number o iterations
+*/
+
+namespace aoc2015::day10 {
+
+std::string parse(std::string_view sequence) {
+  // the sequence may also be read from a file, so drop the trailing newline
+  return std::string(aoc::trim(sequence));
+}
+
+Answer solve(const std::string& sequence) {
+  auto look_and_say = [](const std::string& input, std::string& output) {
+    output.clear();
+    output.reserve(input.size() * 2);
+
+    AOC_ALLOCATION_FREE("day10.look_and_say");
+
+    auto emit = [&output](size_t count, char digit) {
+      char digits[20];
+      auto [end, ec]{std::to_chars(digits, digits + sizeof(digits), count)};
+      output.append(digits, end);
+      output += digit;
+    };
+
+    size_t i{1};
+    size_t count{1};
+    while (i < input.size()) {
+      if (input[i - 1] == input[i]) {
+        ++count;
+      } else {
+        emit(count, input[i - 1]);
+        count = 1;
+      }
+      ++i;
+    }
+    emit(count, input[input.size() - 1]);
+  };
+
+  size_t iterations{50};
+  std::string result{sequence};
+  std::string next{};
+
+  while (iterations > 0) {
+    look_and_say(result, next);
+    std::swap(result, next);
+    --iterations;
+  }
+
+  return Answer{result.size()};
+}
+
+void print(std::ostream& out, const Answer& answer) {
+  out << answer.length << '\n';
+}
+
+}  // namespace aoc2015::day10
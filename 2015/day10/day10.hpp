@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace aoc2015::day10 {
+
+struct Answer {
+  size_t length;
+};
+
+std::string parse(std::string_view sequence);
+Answer solve(const std::string& sequence);
+void print(std::ostream& out, const Answer& answer);
+
+}  // namespace aoc2015::day10
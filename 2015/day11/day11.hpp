@@ -0,0 +1,17 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace aoc2015::day11 {
+
+struct Answer {
+  std::string password;
+};
+
+std::string parse(std::string_view password);
+Answer solve(const std::string& current);
+void print(std::ostream& out, const Answer& answer);
+
+}  // namespace aoc2015::day11
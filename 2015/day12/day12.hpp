@@ -0,0 +1,16 @@
+#pragma once
+
+#include <ostream>
+#include <string_view>
+
+namespace aoc2015::day12 {
+
+struct Answer {
+  int sum;
+};
+
+std::string_view parse(std::string_view buffer);
+Answer solve(std::string_view document);
+void print(std::ostream& out, const Answer& answer);
+
+}  // namespace aoc2015::day12
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+namespace aoc2015::day13 {
+
+// n x n combined happiness of seating each pair together, including self
+using HappinessMatrix = std::vector<std::vector<int>>;
+
+struct Answer {
+  int happiness;
+};
+
+HappinessMatrix parse(std::string_view buffer);
+Answer solve(const HappinessMatrix& adjacency_matrix);
+void print(std::ostream& out, const Answer& answer);
+
+}  // namespace aoc2015::day13
@@ -0,0 +1,112 @@
+#include "day14.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../../common/alloc.hpp"
+#include "../../common/scan.hpp"
+
+/*
+Advent of Code 2015 - Day 14
+
+    Problem:
+        Determine the lead distance and points for the reindeer olympics race
+        given input about the reindeer's speed and fly/rest duration requirements.
+
+    Approach:
+        Parse through the input to construct a vector of `Reindder` to hold
+        their speed values, fly and rest durations along with mutable fields like
+        distance and points. For each second, iterate through the vector of reindeer and
+        update its position according to whether or not its flying or resting. Then,
+        iterate through the vector of reindeer to award a point to the reindeer(s)
+        currently in the lead.
+
+
+    Complexity:
+        O(n * k) time, where n is the number of reindeer and k is the race duration
+        O(n) space, for the vector of reindeer
+*/
+
+namespace aoc2015::day14 {
+
+constexpr int SECONDS_PASSED{2503};
+
+std::vector<Reindeer> parse(std::string_view buffer) {
+  std::vector<Reindeer> reindeers{};
+  size_t pos{};
+
+  while (pos < buffer.size()) {
+    size_t line_end{buffer.find('\n', pos)};
+    if (line_end == std::string_view::npos) {
+      line_end = buffer.size();
+    }
+
+    std::string_view line{buffer.data() + pos, line_end - pos};
+
+    std::string_view name{};
+    int speed{}, fly{}, rest{};
+
+    if (!aoc::scan<"{} can fly {} km/s for {} seconds, but then must rest for "
+                   "{} seconds.">(line, name, speed, fly, rest)) {
+      throw std::runtime_error("invalid line format\n");
+    }
+
+    reindeers.emplace_back(std::string(name), speed, fly, rest,
+                           0 /* distance */, 0 /* points */, 0 /* duration */,
+                           true /* is_flying */);
+
+    pos = line_end + 1;
+  }
+
+  return reindeers;
+}
+
+Answer solve(const std::vector<Reindeer>& starting_line) {
+  std::vector<Reindeer> reindeers{starting_line};
+
+  int winning_distance{std::numeric_limits<int>::min()};
+  int winning_points{std::numeric_limits<int>::min()};
+
+  AOC_ALLOCATION_FREE("day14.race");
+
+  for (size_t i{}; i < SECONDS_PASSED; ++i) {
+    // update reindeer movement
+    for (auto& reindeer : reindeers) {
+      ++reindeer.duration;
+
+      if (reindeer.is_flying) {
+        reindeer.distance += reindeer.speed;
+        winning_distance = std::max(winning_distance, reindeer.distance);
+      }
+
+      if ((reindeer.is_flying && reindeer.duration >= reindeer.fly_duration) ||
+          (!reindeer.is_flying &&
+           reindeer.duration >= reindeer.rest_duration)) {
+        reindeer.duration = 0;
+        reindeer.is_flying = !reindeer.is_flying;
+      }
+    }
+
+    // score reindeers
+    for (auto& reindeer : reindeers) {
+      if (reindeer.distance == winning_distance) {
+        ++reindeer.points;
+        winning_points = std::max(winning_points, reindeer.points);
+      }
+    }
+  }
+
+  return Answer{winning_distance, winning_points};
+}
+
+void print(std::ostream& out, const Answer& answer) {
+  out << "the winning distance is " << answer.winning_distance << '\n';
+  out << "the highest point value is " << answer.winning_points << '\n';
+}
+
+}  // namespace aoc2015::day14
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aoc2015::day14 {
+
+struct Reindeer {
+  std::string name;
+  int speed;
+  int fly_duration;
+  int rest_duration;
+
+  int distance;
+  int points;
+  int duration;
+  bool is_flying;
+};
+
+struct Answer {
+  int winning_distance;
+  int winning_points;
+};
+
+std::vector<Reindeer> parse(std::string_view buffer);
+Answer solve(const std::vector<Reindeer>& starting_line);
+void print(std::ostream& out, const Answer& answer);
+
+}  // namespace aoc2015::day14
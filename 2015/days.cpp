@@ -0,0 +1,74 @@
+#include "days.hpp"
+
+#include <array>
+#include <chrono>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "../common/alloc.hpp"
+#include "day01/day01.hpp"
+#include "day02/day02.hpp"
+#include "day03/day03.hpp"
+#include "day04/day04.hpp"
+#include "day05/day05.hpp"
+#include "day06/day06.hpp"
+#include "day07/day07.hpp"
+#include "day08/day08.hpp"
+#include "day09/day09.hpp"
+#include "day10/day10.hpp"
+#include "day11/day11.hpp"
+#include "day12/day12.hpp"
+#include "day13/day13.hpp"
+#include "day14/day14.hpp"
+
+namespace aoc2015 {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+template <auto Parse, auto Solve, auto Print>
+std::string run(std::string_view input, PhaseTimes& times) {
+  aoc::alloc::Stats heap_at_start{aoc::alloc::current()};
+  auto start{Clock::now()};
+  auto parsed{Parse(input)};
+  auto parsed_at{Clock::now()};
+  aoc::alloc::Stats heap_parsed_at{aoc::alloc::current()};
+  auto answer{Solve(parsed)};
+  auto solved_at{Clock::now()};
+  aoc::alloc::Stats heap_solved_at{aoc::alloc::current()};
+
+  times.parse = parsed_at - start;
+  times.solve = solved_at - parsed_at;
+  times.parse_allocations = heap_parsed_at - heap_at_start;
+  times.solve_allocations = heap_solved_at - heap_parsed_at;
+
+  std::ostringstream out{};
+  Print(out, answer);
+  return out.str();
+}
+
+constexpr std::array DAYS{
+    Day{1, "day01", &run<&day01::parse, &day01::solve, &day01::print>},
+    Day{2, "day02", &run<&day02::parse, &day02::solve, &day02::print>},
+    Day{3, "day03", &run<&day03::parse, &day03::solve, &day03::print>},
+    Day{4, "day04", &run<&day04::parse, &day04::solve, &day04::print>},
+    Day{5, "day05", &run<&day05::parse, &day05::solve, &day05::print>},
+    Day{6, "day06", &run<&day06::parse, &day06::solve, &day06::print>},
+    Day{7, "day07", &run<&day07::parse, &day07::solve, &day07::print>},
+    Day{8, "day08", &run<&day08::parse, &day08::solve, &day08::print>},
+    Day{9, "day09", &run<&day09::parse, &day09::solve, &day09::print>},
+    Day{10, "day10", &run<&day10::parse, &day10::solve, &day10::print>},
+    Day{11, "day11", &run<&day11::parse, &day11::solve, &day11::print>},
+    Day{12, "day12", &run<&day12::parse, &day12::solve, &day12::print>},
+    Day{13, "day13", &run<&day13::parse, &day13::solve, &day13::print>},
+    Day{14, "day14", &run<&day14::parse, &day14::solve, &day14::print>},
+};
+
+}  // namespace
+
+std::span<const Day> all_days() { return DAYS; }
+
+}  // namespace aoc2015
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <chrono>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "../common/alloc.hpp"
+
+/*
+    Registry of every 2015 solution
+
+    Each day is built as a library exposing `parse`, `solve` and `print`, so
+    the benchmark harness can drive all of them through one type-erased entry
+    point and time the phases separately.
+*/
+
+namespace aoc2015 {
+
+// wall time spent in each phase of one run of a solution, plus the heap
+// traffic of each phase when built with AOC_ALLOC_TRACKING
+struct PhaseTimes {
+  std::chrono::nanoseconds parse;
+  std::chrono::nanoseconds solve;
+  aoc::alloc::Stats parse_allocations;
+  aoc::alloc::Stats solve_allocations;
+};
+
+struct Day {
+  int number;
+  // also the stem of the day's input file, e.g. "day01.txt"; day04, day10
+  // and day11 read their puzzle key from that file
+  std::string_view name;
+  std::string (*run)(std::string_view input, PhaseTimes& times);
+};
+
+std::span<const Day> all_days();
+
+}  // namespace aoc2015
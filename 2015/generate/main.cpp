@@ -0,0 +1,532 @@
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+    Advent of Code 2015 – scaled synthetic inputs
+
+    Usage:
+        aoc2015_generate <day> [--size N] [--seed S] [--grid G] [--depth D]
+                         [-o FILE]
+        aoc2015_generate all -o DIR [--seed S]
+
+    Writes an input in the official format for one file-based day, scaled by
+    `--size` (to stdout unless `-o` is given):
+        day01  N parens
+        day02  N boxes
+        day03  N moves
+        day05  N strings
+        day06  N instructions on a G x G grid (default 1000)
+        day07  a circuit of N gates feeding wire a
+        day08  N string literals
+        day09  N cities, fully connected
+        day12  a JSON document with about N values nested up to D deep
+        day13  N guests
+        day14  N reindeer
+
+    `all` fills DIR with dayNN.txt for every day at its default size,
+    including fixed puzzle keys for days 4, 10 and 11, ready for aoc2015 and
+    aoc2015_bench.
+
+    Output depends only on the arguments and the seed: the generator uses its
+    own splitmix64 stream and bounded integers instead of the standard
+    distributions, whose results differ between standard libraries.
+*/
+
+namespace {
+
+class Random {
+ public:
+  explicit Random(uint64_t seed) : state_{seed} {}
+
+  uint64_t next() {
+    uint64_t z{state_ += 0x9e3779b97f4a7c15};
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+  }
+
+  // uniform in [0, bound)
+  uint64_t below(uint64_t bound) {
+    return static_cast<uint64_t>(
+        (static_cast<unsigned __int128>(next()) * bound) >> 64);
+  }
+
+  // uniform in [low, high]
+  int64_t between(int64_t low, int64_t high) {
+    return low + static_cast<int64_t>(below(high - low + 1));
+  }
+
+ private:
+  uint64_t state_;
+};
+
+class Writer {
+ public:
+  explicit Writer(std::FILE* file) : file_{file} { buffer_.reserve(CAPACITY); }
+
+  ~Writer() { flush(); }
+
+  Writer& operator<<(std::string_view sv) {
+    if (buffer_.size() + sv.size() > CAPACITY) {
+      flush();
+    }
+    buffer_ += sv;
+    return *this;
+  }
+
+  Writer& operator<<(char ch) { return *this << std::string_view{&ch, 1}; }
+
+  Writer& operator<<(int64_t value) {
+    char digits[24];
+    auto [ptr, ec]{std::to_chars(digits, digits + sizeof(digits), value)};
+    return *this << std::string_view{digits, static_cast<size_t>(ptr - digits)};
+  }
+
+  void flush() {
+    std::fwrite(buffer_.data(), 1, buffer_.size(), file_);
+    buffer_.clear();
+  }
+
+ private:
+  static constexpr size_t CAPACITY{1 << 20};
+
+  std::FILE* file_;
+  std::string buffer_{};
+};
+
+struct Options {
+  uint64_t size;
+  uint64_t seed{2015};
+  int64_t grid{1000};
+  int64_t depth{20};
+};
+
+// lowercase name for the i-th wire, skipping "a" and "b" which the puzzle
+// reserves for the output and the part 2 override
+std::string wire_name(uint64_t i) {
+  i += 2;
+  std::string name{};
+  do {
+    name += static_cast<char>('a' + i % 26);
+    i /= 26;
+  } while (i > 0);
+  return name;
+}
+
+std::string word(Random& random, size_t length) {
+  std::string result(length, 'a');
+  for (char& ch : result) {
+    ch = static_cast<char>('a' + random.below(26));
+  }
+  return result;
+}
+
+std::string capitalized(Random& random, uint64_t index) {
+  std::string name{word(random, 5)};
+  name.front() = static_cast<char>(name.front() - 'a' + 'A');
+  return name + std::to_string(index);  // keeps names unique
+}
+
+void day01(Writer& out, Random& random, const Options& options) {
+  std::string block(4096, '(');
+  for (uint64_t written{}; written < options.size;) {
+    size_t n{static_cast<size_t>(
+        std::min<uint64_t>(block.size(), options.size - written))};
+    for (size_t i{}; i < n; i += 64) {
+      uint64_t bits{random.next()};
+      for (size_t j{i}; j < std::min(n, i + 64); ++j, bits >>= 1) {
+        block[j] = (bits & 1) ? '(' : ')';
+      }
+    }
+    out << std::string_view{block.data(), n};
+    written += n;
+  }
+}
+
+void day02(Writer& out, Random& random, const Options& options) {
+  for (uint64_t i{}; i < options.size; ++i) {
+    out << random.between(1, 30) << 'x' << random.between(1, 30) << 'x'
+        << random.between(1, 30) << '\n';
+  }
+}
+
+void day03(Writer& out, Random& random, const Options& options) {
+  constexpr std::string_view MOVES{"<>^v"};
+  std::string block(4096, '^');
+  for (uint64_t written{}; written < options.size;) {
+    size_t n{static_cast<size_t>(
+        std::min<uint64_t>(block.size(), options.size - written))};
+    for (size_t i{}; i < n; i += 32) {
+      uint64_t bits{random.next()};
+      for (size_t j{i}; j < std::min(n, i + 32); ++j, bits >>= 2) {
+        block[j] = MOVES[bits & 3];
+      }
+    }
+    out << std::string_view{block.data(), n};
+    written += n;
+  }
+}
+
+void day05(Writer& out, Random& random, const Options& options) {
+  for (uint64_t i{}; i < options.size; ++i) {
+    out << word(random, 16) << '\n';
+  }
+}
+
+void day06(Writer& out, Random& random, const Options& options) {
+  constexpr std::string_view ACTIONS[]{"turn on ", "turn off ", "toggle "};
+  for (uint64_t i{}; i < options.size; ++i) {
+    int64_t x_1{random.between(0, options.grid - 1)};
+    int64_t x_2{random.between(0, options.grid - 1)};
+    int64_t y_1{random.between(0, options.grid - 1)};
+    int64_t y_2{random.between(0, options.grid - 1)};
+    out << ACTIONS[random.below(3)] << std::min(x_1, x_2) << ','
+        << std::min(y_1, y_2) << " through " << std::max(x_1, x_2) << ','
+        << std::max(y_1, y_2) << '\n';
+  }
+}
+
+void day07(Writer& out, Random& random, const Options& options) {
+  // every gate reads wires drawn from anywhere earlier in the circuit. A
+  // random circuit easily loses b altogether (one early shift can leave
+  // everything after it constant), and then both parts print the same
+  // signal, so the generator tracks each wire under b and under its
+  // complement and prefers inputs on which the two still differ
+  std::vector<std::string> lines{};
+  lines.reserve(options.size + 2);
+  uint16_t b{static_cast<uint16_t>(random.below(65536))};
+  lines.push_back(std::to_string(b) + " -> b");
+
+  // index 0 is b, index i + 1 the i-th gate
+  using Signals = std::array<uint16_t, 2>;
+  std::vector<Signals> signals{{b, static_cast<uint16_t>(~b)}};
+  signals.reserve(options.size + 1);
+  // applies `op` to a gate's inputs under both values of b
+  auto each{[](auto op) {
+    return Signals{static_cast<uint16_t>(op(0)),
+                   static_cast<uint16_t>(op(1))};
+  }};
+  auto name{[](uint64_t wire) {
+    return wire == 0 ? std::string("b") : wire_name(wire - 1);
+  }};
+  auto earlier{[&]() {
+    uint64_t wire{random.below(signals.size())};
+    for (int tries{}; tries < 8 && signals[wire][0] == signals[wire][1];
+         ++tries) {
+      wire = random.below(signals.size());
+    }
+    return wire;
+  }};
+
+  uint64_t last_live{};
+  for (uint64_t i{}; i < options.size; ++i) {
+    uint64_t input{earlier()};
+    Signals x{signals[input]};
+    Signals result{};
+    std::string gate{};
+    switch (random.below(6)) {
+      case 0:
+        gate = name(input);
+        result = x;
+        break;
+      case 1:
+        gate.append("NOT ").append(name(input));
+        result = each([&](int k) { return ~x[k]; });
+        break;
+      case 2:
+      case 3: {
+        uint64_t other{earlier()};
+        Signals y{signals[other]};
+        bool both{random.below(2) == 0};
+        gate.append(name(input))
+            .append(both ? " AND " : " OR ")
+            .append(name(other));
+        result = both ? each([&](int k) { return x[k] & y[k]; })
+                      : each([&](int k) { return x[k] | y[k]; });
+        break;
+      }
+      case 4: {
+        int64_t by{random.between(1, 15)};
+        gate.append(name(input)).append(" LSHIFT ").append(
+            std::to_string(by));
+        result = each([&](int k) { return x[k] << by; });
+        break;
+      }
+      default: {
+        int64_t by{random.between(1, 15)};
+        gate.append(name(input)).append(" RSHIFT ").append(
+            std::to_string(by));
+        result = each([&](int k) { return x[k] >> by; });
+        break;
+      }
+    }
+    lines.push_back(gate.append(" -> ").append(wire_name(i)));
+    signals.push_back(result);
+    if (result[0] != result[1]) {
+      last_live = i + 1;
+    }
+  }
+  lines.push_back(name(last_live) + " -> a");
+
+  // the puzzle lists gates in no particular order
+  for (size_t i{lines.size() - 1}; i > 0; --i) {
+    std::swap(lines[i], lines[random.below(i + 1)]);
+  }
+  for (const std::string& line : lines) {
+    out << line << '\n';
+  }
+}
+
+void day08(Writer& out, Random& random, const Options& options) {
+  constexpr std::string_view HEX{"0123456789abcdef"};
+  for (uint64_t i{}; i < options.size; ++i) {
+    out << '"';
+    for (int64_t n{random.between(0, 30)}; n > 0; --n) {
+      switch (random.below(10)) {
+        case 0:
+          out << "\\\\";
+          break;
+        case 1:
+          out << "\\\"";
+          break;
+        case 2:
+          out << "\\x" << HEX[random.below(16)] << HEX[random.below(16)];
+          break;
+        default:
+          out << static_cast<char>('a' + random.below(26));
+          break;
+      }
+    }
+    out << "\"\n";
+  }
+}
+
+void day09(Writer& out, Random& random, const Options& options) {
+  std::vector<std::string> cities{};
+  for (uint64_t i{}; i < options.size; ++i) {
+    cities.push_back(capitalized(random, i));
+  }
+  for (size_t i{}; i < cities.size(); ++i) {
+    for (size_t j{i + 1}; j < cities.size(); ++j) {
+      out << cities[i] << " to " << cities[j] << " = "
+          << random.between(1, 1000) << '\n';
+    }
+  }
+}
+
+void json_value(Writer& out, Random& random, int64_t depth,
+                uint64_t& remaining) {
+  uint64_t kind{depth <= 0 ? 2 : random.below(4)};
+  if (kind >= 2 || remaining == 0) {
+    if (remaining > 0) {
+      --remaining;
+    }
+    if (random.below(8) == 0) {
+      out << (random.below(2) == 0 ? "\"red\"" : "\"blue\"");
+    } else {
+      out << random.between(-1000, 1000);
+    }
+    return;
+  }
+
+  bool object{kind == 0};
+  out << (object ? '{' : '[');
+  for (int64_t n{random.between(0, 6)}; n > 0 && remaining > 0; --n) {
+    if (object) {
+      out << '"' << word(random, 3) << "\":";
+    }
+    json_value(out, random, depth - 1, remaining);
+    if (n > 1 && remaining > 0) {
+      out << ',';
+    }
+  }
+  out << (object ? '}' : ']');
+}
+
+void day12(Writer& out, Random& random, const Options& options) {
+  uint64_t remaining{options.size};
+  out << '[';
+  while (remaining > 0) {
+    json_value(out, random, options.depth - 1, remaining);
+    if (remaining > 0) {
+      out << ',';
+    }
+  }
+  out << ']';
+}
+
+void day13(Writer& out, Random& random, const Options& options) {
+  std::vector<std::string> guests{};
+  for (uint64_t i{}; i < options.size; ++i) {
+    guests.push_back(capitalized(random, i));
+  }
+  for (const std::string& guest : guests) {
+    for (const std::string& neighbour : guests) {
+      if (&guest == &neighbour) {
+        continue;
+      }
+      out << guest << " would " << (random.below(2) == 0 ? "gain " : "lose ")
+          << random.between(1, 100) << " happiness units by sitting next to "
+          << neighbour << ".\n";
+    }
+  }
+}
+
+void day14(Writer& out, Random& random, const Options& options) {
+  for (uint64_t i{}; i < options.size; ++i) {
+    out << capitalized(random, i) << " can fly " << random.between(2, 30)
+        << " km/s for " << random.between(2, 20)
+        << " seconds, but then must rest for " << random.between(20, 200)
+        << " seconds.\n";
+  }
+}
+
+struct Generator {
+  std::string_view name;
+  void (*generate)(Writer&, Random&, const Options&);
+  uint64_t default_size;
+};
+
+constexpr Generator GENERATORS[]{
+    {"day01", day01, 10'000'000}, {"day02", day02, 1'000'000},
+    {"day03", day03, 10'000'000}, {"day05", day05, 1'000'000},
+    {"day06", day06, 10'000},     {"day07", day07, 500'000},
+    {"day08", day08, 1'000'000},  {"day09", day09, 16},
+    {"day12", day12, 1'000'000},  {"day13", day13, 12},
+    {"day14", day14, 10'000},
+};
+
+// the remaining days take a short puzzle key instead of a file
+constexpr std::pair<std::string_view, std::string_view> KEYS[]{
+    {"day04", "abcdef"}, {"day10", "1113222113"}, {"day11", "abcdefgh"}};
+
+bool parse_number(std::string_view sv, auto& out) {
+  auto [ptr, ec]{std::from_chars(sv.data(), sv.data() + sv.size(), out)};
+  return ec == std::errc{} && ptr == sv.data() + sv.size();
+}
+
+std::string normalize_day(std::string_view day) {
+  if (day.starts_with("day")) {
+    day.remove_prefix(3);
+  }
+  return day.size() == 1 ? "day0" + std::string(day) : "day" + std::string(day);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    std::cerr << "usage: aoc2015_generate <day|all> [--size N] [--seed S] "
+                 "[--grid G] [--depth D] [-o PATH]\n";
+    return -1;
+  }
+
+  std::string_view day{argv[1]};
+  Options options{};
+  bool size_given{};
+  const char* output{};
+
+  for (int i{2}; i < argc; ++i) {
+    std::string_view arg{argv[i]};
+    if (i + 1 >= argc) {
+      std::cerr << "missing value for " << arg << '\n';
+      return -1;
+    }
+    std::string_view value{argv[++i]};
+
+    bool ok{true};
+    if (arg == "--size") {
+      ok = parse_number(value, options.size);
+      size_given = true;
+    } else if (arg == "--seed") {
+      ok = parse_number(value, options.seed);
+    } else if (arg == "--grid") {
+      ok = parse_number(value, options.grid) && options.grid > 0;
+    } else if (arg == "--depth") {
+      ok = parse_number(value, options.depth) && options.depth > 0;
+    } else if (arg == "-o") {
+      output = value.data();
+    } else {
+      std::cerr << "unknown option " << arg << '\n';
+      return -1;
+    }
+
+    if (!ok) {
+      std::cerr << "invalid value for " << arg << ": " << value << '\n';
+      return -1;
+    }
+  }
+
+  if (day == "all") {
+    if (output == nullptr) {
+      std::cerr << "all needs an output directory: -o DIR\n";
+      return -1;
+    }
+    std::filesystem::path dir{output};
+    std::filesystem::create_directories(dir);
+
+    for (const Generator& generator : GENERATORS) {
+      std::filesystem::path path{dir / (std::string(generator.name) + ".txt")};
+      std::unique_ptr<std::FILE, int (*)(std::FILE*)> file{
+          std::fopen(path.c_str(), "wb"), &std::fclose};
+      if (!file) {
+        std::cerr << "could not open " << path << '\n';
+        return -1;
+      }
+
+      Options day_options{options};
+      day_options.size = generator.default_size;
+      Random random{options.seed};
+      Writer out{file.get()};
+      generator.generate(out, random, day_options);
+    }
+
+    for (const auto& [name, key] : KEYS) {
+      std::filesystem::path path{dir / (std::string(name) + ".txt")};
+      std::unique_ptr<std::FILE, int (*)(std::FILE*)> file{
+          std::fopen(path.c_str(), "wb"), &std::fclose};
+      if (!file) {
+        std::cerr << "could not open " << path << '\n';
+        return -1;
+      }
+
+      Writer out{file.get()};
+      out << key << '\n';
+    }
+    return 0;
+  }
+
+  std::string name{normalize_day(day)};
+  auto generator{std::ranges::find(GENERATORS, name, &Generator::name)};
+  if (generator == std::end(GENERATORS)) {
+    std::cerr << "no generator for " << day << '\n';
+    return -1;
+  }
+
+  if (!size_given) {
+    options.size = generator->default_size;
+  }
+
+  std::unique_ptr<std::FILE, int (*)(std::FILE*)> file{
+      output == nullptr ? stdout : std::fopen(output, "wb"),
+      output == nullptr ? [](std::FILE*) { return 0; } : &std::fclose};
+  if (!file) {
+    std::cerr << "could not open " << output << '\n';
+    return -1;
+  }
+
+  Random random{options.seed};
+  Writer out{file.get()};
+  generator->generate(out, random, options);
+
+  return 0;
+}
@@ -0,0 +1,171 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "../../common/args.hpp"
+#include "../../common/input.hpp"
+#include "../../common/metrics.hpp"
+#include "../../common/thread_pool.hpp"
+#include "../days.hpp"
+
+/*
+    Advent of Code 2015 – all days in one process
+
+    Usage:
+        aoc2015 <input-dir> [--threads N] [--stats]
+
+    Loads `<input-dir>/dayNN.txt` for every day that has one and schedules the
+    days on a work-stealing thread pool. The expensive searches (day04's MD5
+    loop, day10's 50 look-and-say rounds, ...) are submitted first so they
+    start right away, and the cheap days are stolen by whichever workers are
+    free around them, so the whole year should take about as long as its
+    slowest day.
+
+    Each day's answers are printed in day order along with its own latency
+    (load + parse + solve) and when it finished relative to the start.
+*/
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// rough cost order so the long searches are picked up first
+constexpr std::array MOST_EXPENSIVE_FIRST{4, 10, 6, 13, 9, 11, 14, 7,
+                                          3, 12, 5, 2, 8, 1};
+
+struct Report {
+  bool ran;
+  std::string answer;
+  std::string error;
+  std::chrono::nanoseconds latency;
+  std::chrono::nanoseconds finished_at;
+};
+
+double to_ms(std::chrono::nanoseconds ns) {
+  return std::chrono::duration<double, std::milli>(ns).count();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    std::cerr << "usage: aoc2015 <input-dir> [--threads N] [--stats]\n";
+    return -1;
+  }
+
+  const std::filesystem::path input_dir{argv[1]};
+  size_t threads{std::thread::hardware_concurrency()};
+
+  for (int i{2}; i < argc; ++i) {
+    std::string_view arg{argv[i]};
+    if (arg == "--threads" && i + 1 < argc) {
+      std::string_view value{argv[++i]};
+      std::optional<size_t> count{aoc::positive_count(value)};
+      if (!count.has_value()) {
+        std::cerr << value << ": --threads needs a count of at least 1\n";
+        return -1;
+      }
+      threads = *count;
+    } else if (arg == "--stats") {
+      continue;  // handled after the run
+    } else {
+      std::cerr << "unknown option " << arg << '\n';
+      return -1;
+    }
+  }
+
+  std::span<const aoc2015::Day> days{aoc2015::all_days()};
+  std::vector<Report> reports(days.size());
+
+  std::vector<const aoc2015::Day*> order{};
+  for (int number : MOST_EXPENSIVE_FIRST) {
+    auto it{std::ranges::find(days, number, &aoc2015::Day::number)};
+    if (it != days.end()) {
+      order.push_back(&*it);
+    }
+  }
+
+  auto start{Clock::now()};
+  {
+    aoc::ThreadPool pool{threads};
+
+    for (const aoc2015::Day* day : order) {
+      std::filesystem::path path{input_dir /
+                                 (std::string(day->name) + ".txt")};
+      if (!std::filesystem::exists(path)) {
+        continue;
+      }
+
+      Report& report{reports[day - days.data()]};
+      pool.submit([day, path, start, &report] {
+        auto day_start{Clock::now()};
+        try {
+          const aoc::Input input{path.c_str()};
+          aoc2015::PhaseTimes times{};
+          report.answer = day->run(input.view(), times);
+        } catch (const std::exception& e) {
+          report.error = e.what();
+        }
+        auto day_end{Clock::now()};
+
+        report.ran = true;
+        report.latency = day_end - day_start;
+        report.finished_at = day_end - start;
+      });
+    }
+
+    pool.wait();
+  }
+  std::chrono::nanoseconds wall{Clock::now() - start};
+
+  const aoc2015::Day* slowest{};
+  std::chrono::nanoseconds slowest_latency{};
+  int failures{};
+
+  std::cout << std::fixed << std::setprecision(3);
+  for (size_t i{}; i < days.size(); ++i) {
+    const Report& report{reports[i]};
+    if (!report.ran) {
+      continue;
+    }
+
+    std::cout << "== " << days[i].name << " (" << to_ms(report.latency)
+              << " ms, finished at " << to_ms(report.finished_at)
+              << " ms)\n";
+    if (report.error.empty()) {
+      std::cout << report.answer;
+    } else {
+      std::cout << "error: " << report.error << '\n';
+      ++failures;
+    }
+
+    if (report.latency > slowest_latency) {
+      slowest_latency = report.latency;
+      slowest = &days[i];
+    }
+  }
+
+  std::cout << "total wall time: " << to_ms(wall) << " ms on " << threads
+            << " threads";
+  if (slowest != nullptr) {
+    std::cout << " (slowest day: " << slowest->name << " at "
+              << to_ms(slowest_latency) << " ms)";
+  }
+  std::cout << '\n';
+
+  if (aoc::metrics::stats_requested(argc, argv)) {
+    aoc::metrics::report(std::cerr);
+  }
+
+  return failures == 0 ? 0 : 1;
+}
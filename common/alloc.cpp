@@ -0,0 +1,99 @@
+#include "alloc.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/*
+    Counting replacements for the global allocation functions
+
+    Only built with `-DAOC_ALLOC_TRACKING=ON`. The plain and aligned forms are
+    replaced; the array and nothrow forms in libstdc++ forward to these, so
+    every heap allocation passes through `count`.
+
+    The per-thread state is constant-initialized, so touching it from inside
+    `operator new` never allocates or runs a TLS initializer.
+*/
+
+namespace aoc::alloc {
+
+namespace {
+
+thread_local constinit uint64_t allocations{};
+thread_local constinit uint64_t bytes{};
+thread_local constinit const char* scope{};
+
+std::atomic<uint64_t> violation_count{};
+std::atomic<const char*> first_violating_scope{};
+
+void count(size_t size) {
+  ++allocations;
+  bytes += size;
+
+  if (scope != nullptr) {
+    violation_count.fetch_add(1, std::memory_order_relaxed);
+    const char* expected{nullptr};
+    first_violating_scope.compare_exchange_strong(expected, scope);
+  }
+}
+
+void* allocate(size_t size) {
+  count(size);
+  void* ptr{std::malloc(size == 0 ? 1 : size)};
+  if (ptr == nullptr) {
+    throw std::bad_alloc{};
+  }
+  return ptr;
+}
+
+void* allocate_aligned(size_t size, std::align_val_t alignment) {
+  count(size);
+  size_t align{static_cast<size_t>(alignment)};
+  // aligned_alloc wants a size that is a multiple of the alignment
+  size_t rounded{(size + align - 1) / align * align};
+  void* ptr{std::aligned_alloc(align, rounded == 0 ? align : rounded)};
+  if (ptr == nullptr) {
+    throw std::bad_alloc{};
+  }
+  return ptr;
+}
+
+}  // namespace
+
+Stats current() { return Stats{allocations, bytes}; }
+
+uint64_t violations() {
+  return violation_count.load(std::memory_order_relaxed);
+}
+
+const char* first_violation() { return first_violating_scope.load(); }
+
+AllocationFreeScope::AllocationFreeScope(const char* name) : outer_{scope} {
+  scope = name;
+}
+
+AllocationFreeScope::~AllocationFreeScope() { scope = outer_; }
+
+AllocationsAllowed::AllocationsAllowed() : suspended_{scope} {
+  scope = nullptr;
+}
+
+AllocationsAllowed::~AllocationsAllowed() { scope = suspended_; }
+
+}  // namespace aoc::alloc
+
+void* operator new(size_t size) { return aoc::alloc::allocate(size); }
+
+void* operator new(size_t size, std::align_val_t alignment) {
+  return aoc::alloc::allocate_aligned(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+
+/*
+    Heap allocation tracking
+
+    With the CMake option `-DAOC_ALLOC_TRACKING=ON` (which defines
+    `AOC_ALLOC_TRACKING`), global `operator new`/`delete` are replaced by
+    counting versions (common/alloc.cpp) and every thread keeps a running
+    total of its allocations and requested bytes:
+
+        aoc::alloc::Stats before{aoc::alloc::current()};
+        parse(...);
+        aoc::alloc::Stats parse_cost{aoc::alloc::current() - before};
+
+    Loops that must not touch the heap are marked with a scope:
+
+        {
+          AOC_ALLOCATION_FREE("day06.replay");
+          for (...) { ... }
+        }
+
+    Any allocation while such a scope is open is recorded as a violation,
+    which the benchmark harness turns into a failing exit status.
+
+    Code that may legitimately allocate once from inside such a loop, like
+    the metrics registry adding a new name, lifts the scope for its own
+    duration with `AllocationsAllowed`.
+
+    Without the option nothing is replaced, `current()` always returns zero
+    and the scope macro expands to nothing.
+*/
+
+namespace aoc::alloc {
+
+#ifdef AOC_ALLOC_TRACKING
+inline constexpr bool ENABLED{true};
+#else
+inline constexpr bool ENABLED{false};
+#endif
+
+struct Stats {
+  uint64_t allocations;
+  uint64_t bytes;
+
+  friend Stats operator-(const Stats& lhs, const Stats& rhs) {
+    return Stats{lhs.allocations - rhs.allocations, lhs.bytes - rhs.bytes};
+  }
+};
+
+#ifdef AOC_ALLOC_TRACKING
+
+// running totals for the calling thread
+Stats current();
+
+// allocations made inside allocation-free scopes, across all threads
+uint64_t violations();
+
+// name of the first scope that allocated, or nullptr
+const char* first_violation();
+
+class AllocationFreeScope {
+ public:
+  explicit AllocationFreeScope(const char* name);
+  ~AllocationFreeScope();
+
+  AllocationFreeScope(const AllocationFreeScope&) = delete;
+  AllocationFreeScope& operator=(const AllocationFreeScope&) = delete;
+
+ private:
+  const char* outer_;
+};
+
+// suspends the calling thread's allocation-free scope until destroyed
+class AllocationsAllowed {
+ public:
+  AllocationsAllowed();
+  ~AllocationsAllowed();
+
+  AllocationsAllowed(const AllocationsAllowed&) = delete;
+  AllocationsAllowed& operator=(const AllocationsAllowed&) = delete;
+
+ private:
+  const char* suspended_;
+};
+
+#else
+
+inline Stats current() { return {}; }
+inline uint64_t violations() { return 0; }
+inline const char* first_violation() { return nullptr; }
+
+class AllocationsAllowed {
+ public:
+  // user-provided, so guards are not reported as unused variables
+  AllocationsAllowed() {}
+};
+
+#endif
+
+}  // namespace aoc::alloc
+
+#define AOC_ALLOC_CONCAT_INNER(a, b) a##b
+#define AOC_ALLOC_CONCAT(a, b) AOC_ALLOC_CONCAT_INNER(a, b)
+
+#ifdef AOC_ALLOC_TRACKING
+#define AOC_ALLOCATION_FREE(name)                                      \
+  ::aoc::alloc::AllocationFreeScope AOC_ALLOC_CONCAT(aoc_alloc_scope_, \
+                                                     __LINE__) {       \
+    name                                                               \
+  }
+#else
+#define AOC_ALLOCATION_FREE(name)
+#endif
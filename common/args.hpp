@@ -0,0 +1,43 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+namespace aoc {
+
+// true if `flag` appears anywhere after the program name
+inline bool has_flag(int argc, char* argv[], std::string_view flag) {
+  for (int i{1}; i < argc; ++i) {
+    if (std::string_view{argv[i]} == flag) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// the argument following `option`, or nullptr if it is absent or last
+inline const char* option_value(int argc, char* argv[],
+                                std::string_view option) {
+  for (int i{1}; i + 1 < argc; ++i) {
+    if (std::string_view{argv[i]} == option) {
+      return argv[i + 1];
+    }
+  }
+  return nullptr;
+}
+
+// `text` as a whole decimal count above zero, e.g. a `--threads` value, or
+// nullopt if it is anything else
+inline std::optional<size_t> positive_count(std::string_view text) {
+  size_t value{};
+  auto [ptr, ec]{std::from_chars(text.data(), text.data() + text.size(),
+                                 value)};
+  if (ec != std::errc{} || ptr != text.data() + text.size() || value == 0) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+}  // namespace aoc
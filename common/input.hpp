@@ -0,0 +1,155 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+/*
+    Shared input loader
+
+    Regular files are mapped read-only with `mmap` and hinted with
+    `madvise(MADV_SEQUENTIAL)` so the solvers work directly on the page cache
+    through a `std::string_view` instead of copying the whole file into a heap
+    `std::string`.
+
+    The mapping reserves one anonymous page past the end of the file, so the
+    view is always followed by a '\0' sentinel just like `std::string::data()`
+    and parsers that peek one character past the end stay in bounds.
+
+    Pipes, character devices and stdin (passed as "-") cannot be mapped, so
+    they fall back to a buffered `read` loop into an owned `std::string`.
+*/
+
+namespace aoc {
+
+class Input {
+ public:
+  explicit Input(const char* path) {
+    bool use_stdin{std::strcmp(path, "-") == 0};
+    int fd{use_stdin ? STDIN_FILENO : ::open(path, O_RDONLY | O_CLOEXEC)};
+    if (fd < 0) {
+      throw std::runtime_error("could not open input file");
+    }
+
+    struct stat st{};
+    if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+      map_file(fd, static_cast<size_t>(st.st_size));
+    } else {
+      read_stream(fd);
+    }
+
+    if (!use_stdin) {
+      ::close(fd);
+    }
+  }
+
+  ~Input() { release(); }
+
+  Input(const Input&) = delete;
+  Input& operator=(const Input&) = delete;
+
+  Input(Input&& other) noexcept
+      : mapping_{std::exchange(other.mapping_, nullptr)},
+        mapping_size_{std::exchange(other.mapping_size_, 0)},
+        size_{std::exchange(other.size_, 0)},
+        owned_{std::move(other.owned_)} {}
+
+  Input& operator=(Input&& other) noexcept {
+    if (this != &other) {
+      release();
+      mapping_ = std::exchange(other.mapping_, nullptr);
+      mapping_size_ = std::exchange(other.mapping_size_, 0);
+      size_ = std::exchange(other.size_, 0);
+      owned_ = std::move(other.owned_);
+    }
+    return *this;
+  }
+
+  std::string_view view() const {
+    if (mapping_ != nullptr) {
+      return {static_cast<const char*>(mapping_), size_};
+    }
+    return owned_;
+  }
+
+  bool is_mapped() const { return mapping_ != nullptr; }
+
+ private:
+  void map_file(int fd, size_t size) {
+    size_t page{static_cast<size_t>(::sysconf(_SC_PAGESIZE))};
+    size_t reserved{(size / page + 1) * page};  // at least one zeroed page
+
+    // reserve the sentinel-padded range, then map the file over its start
+    void* base{::mmap(nullptr, reserved, PROT_READ,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)};
+    if (base == MAP_FAILED) {
+      read_stream(fd);
+      return;
+    }
+
+    void* file{::mmap(base, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0)};
+    if (file == MAP_FAILED) {
+      ::munmap(base, reserved);
+      read_stream(fd);
+      return;
+    }
+
+    ::madvise(file, size, MADV_SEQUENTIAL);
+
+    mapping_ = file;
+    mapping_size_ = reserved;
+    size_ = size;
+  }
+
+  void read_stream(int fd) {
+    constexpr size_t CHUNK_SIZE{1 << 16};
+
+    size_t used{};
+    while (true) {
+      owned_.resize(used + CHUNK_SIZE);
+      ssize_t n{::read(fd, owned_.data() + used, CHUNK_SIZE)};
+      if (n < 0) {
+        throw std::runtime_error("could not read input file");
+      }
+      if (n == 0) {
+        break;
+      }
+      used += static_cast<size_t>(n);
+    }
+    owned_.resize(used);
+  }
+
+  void release() {
+    if (mapping_ != nullptr) {
+      ::munmap(mapping_, mapping_size_);
+      mapping_ = nullptr;
+    }
+  }
+
+  void* mapping_{};
+  size_t mapping_size_{};
+  size_t size_{};
+  std::string owned_{};
+};
+
+// strips surrounding whitespace from single-value inputs such as a puzzle key
+// read from a file
+inline std::string_view trim(std::string_view sv) {
+  constexpr std::string_view WHITESPACE{" \t\r\n"};
+
+  size_t start{sv.find_first_not_of(WHITESPACE)};
+  if (start == std::string_view::npos) {
+    return {};
+  }
+  size_t end{sv.find_last_not_of(WHITESPACE)};
+  return sv.substr(start, end - start + 1);
+}
+
+}  // namespace aoc
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/*
+    Minimal JSON reader
+
+    Enough JSON to read back the reports our own tools write (benchmark
+    baselines): objects, arrays, numbers, strings with simple escapes, true,
+    false and null. Values are parsed into a small tree; objects keep their
+    members in document order and are searched linearly, which is fine for
+    the few dozen keys a report has.
+
+        aoc::json::Value report{aoc::json::parse(text)};
+        for (const auto& day : report["days"].array) { ... }
+
+    Malformed input throws `std::runtime_error`.
+*/
+
+namespace aoc::json {
+
+struct Value {
+  enum class Kind { NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+
+  Kind kind{Kind::NUL};
+  bool boolean{};
+  double number{};
+  std::string string{};
+  std::vector<Value> array{};
+  std::vector<std::pair<std::string, Value>> object{};
+
+  // member lookup; nullptr if this is not an object or has no such key
+  const Value* find(std::string_view key) const {
+    for (const auto& [name, value] : object) {
+      if (name == key) {
+        return &value;
+      }
+    }
+    return nullptr;
+  }
+
+  const Value& operator[](std::string_view key) const {
+    const Value* value{find(key)};
+    if (value == nullptr) {
+      throw std::runtime_error("missing JSON key " + std::string(key));
+    }
+    return *value;
+  }
+};
+
+namespace detail {
+
+class Parser {
+ public:
+  explicit Parser(std::string_view text) : text_{text} {}
+
+  Value document() {
+    Value value{parse_value()};
+    skip_whitespace();
+    if (pos_ != text_.size()) {
+      fail("trailing characters");
+    }
+    return value;
+  }
+
+ private:
+  [[noreturn]] void fail(const char* what) {
+    throw std::runtime_error("invalid JSON at offset " + std::to_string(pos_) +
+                             ": " + what);
+  }
+
+  void skip_whitespace() {
+    while (pos_ < text_.size() &&
+           (text_[pos_] == ' ' || text_[pos_] == '\n' || text_[pos_] == '\r' ||
+            text_[pos_] == '\t')) {
+      ++pos_;
+    }
+  }
+
+  void expect(char ch) {
+    skip_whitespace();
+    if (pos_ >= text_.size() || text_[pos_] != ch) {
+      fail("unexpected character");
+    }
+    ++pos_;
+  }
+
+  bool consume(std::string_view word) {
+    if (text_.substr(pos_, word.size()) == word) {
+      pos_ += word.size();
+      return true;
+    }
+    return false;
+  }
+
+  Value parse_value() {
+    skip_whitespace();
+    if (pos_ >= text_.size()) {
+      fail("unexpected end of input");
+    }
+
+    Value value{};
+    char ch{text_[pos_]};
+    if (ch == '{') {
+      value.kind = Value::Kind::OBJECT;
+      parse_object(value);
+    } else if (ch == '[') {
+      value.kind = Value::Kind::ARRAY;
+      parse_array(value);
+    } else if (ch == '"') {
+      value.kind = Value::Kind::STRING;
+      value.string = parse_string();
+    } else if (consume("true")) {
+      value.kind = Value::Kind::BOOLEAN;
+      value.boolean = true;
+    } else if (consume("false")) {
+      value.kind = Value::Kind::BOOLEAN;
+    } else if (consume("null")) {
+      value.kind = Value::Kind::NUL;
+    } else {
+      value.kind = Value::Kind::NUMBER;
+      auto [ptr, ec]{std::from_chars(text_.data() + pos_,
+                                     text_.data() + text_.size(),
+                                     value.number)};
+      if (ec != std::errc{}) {
+        fail("expected a value");
+      }
+      pos_ = static_cast<size_t>(ptr - text_.data());
+    }
+    return value;
+  }
+
+  void parse_object(Value& value) {
+    expect('{');
+    skip_whitespace();
+    if (consume("}")) {
+      return;
+    }
+    while (true) {
+      skip_whitespace();
+      std::string key{parse_string()};
+      expect(':');
+      value.object.emplace_back(std::move(key), parse_value());
+
+      skip_whitespace();
+      if (consume("}")) {
+        return;
+      }
+      expect(',');
+    }
+  }
+
+  void parse_array(Value& value) {
+    expect('[');
+    skip_whitespace();
+    if (consume("]")) {
+      return;
+    }
+    while (true) {
+      value.array.push_back(parse_value());
+
+      skip_whitespace();
+      if (consume("]")) {
+        return;
+      }
+      expect(',');
+    }
+  }
+
+  std::string parse_string() {
+    expect('"');
+    std::string result{};
+    while (pos_ < text_.size() && text_[pos_] != '"') {
+      char ch{text_[pos_++]};
+      if (ch == '\\') {
+        if (pos_ >= text_.size()) {
+          break;
+        }
+        switch (char escaped{text_[pos_++]}) {
+          case 'n':
+            result += '\n';
+            break;
+          case 't':
+            result += '\t';
+            break;
+          case 'r':
+            result += '\r';
+            break;
+          default:  // \" \\ \/ stand for themselves
+            result += escaped;
+            break;
+        }
+      } else {
+        result += ch;
+      }
+    }
+    expect('"');
+    return result;
+  }
+
+  std::string_view text_;
+  size_t pos_{};
+};
+
+}  // namespace detail
+
+inline Value parse(std::string_view text) {
+  return detail::Parser{text}.document();
+}
+
+}  // namespace aoc::json
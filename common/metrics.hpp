@@ -0,0 +1,224 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "alloc.hpp"
+#include "args.hpp"
+
+/*
+    Hot-path counters and scoped timers
+
+    Instrumentation is compiled in only when `AOC_METRICS` is defined (CMake
+    option `-DAOC_METRICS=ON`); otherwise every macro expands to nothing and
+    the arguments are never evaluated, so the hot loops pay nothing.
+
+        AOC_COUNT("day09.held_karp.calls", 1);
+        AOC_SCOPED_TIMER("day04.search");
+        AOC_RATIO("day06.cells_per_instruction", "day06.replay.cells",
+                  "day06.replay.instructions");
+
+    Names are dotted paths. A counter nested under a timer's name (for example
+    "day04.search.hashes" under "day04.search") is also reported as a rate
+    over that timer's total time. Ratios divide one counter by another.
+
+    Counters are relaxed atomics registered once per call site, so they are
+    safe to bump from the runner's worker threads. Registering a name
+    allocates, so it lifts any `AOC_ALLOCATION_FREE` scope around the call
+    site; bumping a counter afterwards never touches the heap.
+*/
+
+namespace aoc::metrics {
+
+#ifdef AOC_METRICS
+inline constexpr bool ENABLED{true};
+#else
+inline constexpr bool ENABLED{false};
+#endif
+
+struct Counter {
+  std::atomic<uint64_t> value{};
+
+  void add(uint64_t amount) {
+    value.fetch_add(amount, std::memory_order_relaxed);
+  }
+};
+
+struct Timer {
+  std::atomic<uint64_t> total_ns{};
+  std::atomic<uint64_t> calls{};
+};
+
+class ScopedTimer {
+ public:
+  explicit ScopedTimer(Timer& timer)
+      : timer_{timer}, start_{std::chrono::steady_clock::now()} {}
+
+  ~ScopedTimer() {
+    std::chrono::nanoseconds elapsed{std::chrono::steady_clock::now() - start_};
+    timer_.total_ns.fetch_add(elapsed.count(), std::memory_order_relaxed);
+    timer_.calls.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+ private:
+  Timer& timer_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+class Registry {
+ public:
+  static Registry& instance() {
+    alloc::AllocationsAllowed registering{};
+    static Registry registry{};
+    return registry;
+  }
+
+  Counter& counter(std::string_view name) {
+    alloc::AllocationsAllowed registering{};
+    std::lock_guard lock{mutex_};
+    auto [it, inserted] = counters_.try_emplace(std::string(name), nullptr);
+    if (inserted) {
+      it->second = &counter_storage_.emplace_back();
+    }
+    return *it->second;
+  }
+
+  Timer& timer(std::string_view name) {
+    alloc::AllocationsAllowed registering{};
+    std::lock_guard lock{mutex_};
+    auto [it, inserted] = timers_.try_emplace(std::string(name), nullptr);
+    if (inserted) {
+      it->second = &timer_storage_.emplace_back();
+    }
+    return *it->second;
+  }
+
+  bool ratio(std::string_view name, std::string_view numerator,
+             std::string_view denominator) {
+    alloc::AllocationsAllowed registering{};
+    std::lock_guard lock{mutex_};
+    ratios_.try_emplace(std::string(name), std::string(numerator),
+                        std::string(denominator));
+    return true;
+  }
+
+  void report(std::ostream& out) {
+    std::lock_guard lock{mutex_};
+
+    out << "-- metrics --\n" << std::fixed << std::setprecision(3);
+
+    for (const auto& [name, timer] : timers_) {
+      uint64_t calls{timer->calls.load(std::memory_order_relaxed)};
+      double total_ms{timer->total_ns.load(std::memory_order_relaxed) / 1e6};
+      out << "timer    " << std::left << std::setw(40) << name << std::right
+          << total_ms << " ms over " << calls << " call(s)\n";
+    }
+
+    for (const auto& [name, counter] : counters_) {
+      uint64_t value{counter->value.load(std::memory_order_relaxed)};
+      out << "counter  " << std::left << std::setw(40) << name << std::right
+          << value;
+
+      // a counter nested under a timer is reported as a rate over it
+      size_t dot{name.rfind('.')};
+      auto timer{dot == std::string::npos ? timers_.end()
+                                          : timers_.find(name.substr(0, dot))};
+      if (timer != timers_.end()) {
+        uint64_t ns{timer->second->total_ns.load(std::memory_order_relaxed)};
+        if (ns > 0) {
+          out << " (" << value * 1e9 / ns << " /s)";
+        }
+      }
+      out << '\n';
+    }
+
+    for (const auto& [name, parts] : ratios_) {
+      auto numerator{counters_.find(parts.first)};
+      auto denominator{counters_.find(parts.second)};
+      if (numerator == counters_.end() || denominator == counters_.end()) {
+        continue;
+      }
+      uint64_t bottom{denominator->second->value.load()};
+      out << "ratio    " << std::left << std::setw(40) << name << std::right
+          << (bottom == 0 ? 0.0
+                          : static_cast<double>(
+                                numerator->second->value.load()) /
+                                bottom)
+          << '\n';
+    }
+  }
+
+ private:
+  std::mutex mutex_{};
+  std::deque<Counter> counter_storage_{};
+  std::deque<Timer> timer_storage_{};
+  std::map<std::string, Counter*> counters_{};
+  std::map<std::string, Timer*> timers_{};
+  std::map<std::string, std::pair<std::string, std::string>> ratios_{};
+};
+
+inline bool stats_requested(int argc, char* argv[]) {
+  return has_flag(argc, argv, "--stats");
+}
+
+inline void report(std::ostream& out) {
+  if constexpr (!ENABLED) {
+    out << "metrics were compiled out; rebuild with -DAOC_METRICS=ON\n";
+  } else {
+    Registry::instance().report(out);
+  }
+}
+
+}  // namespace aoc::metrics
+
+#define AOC_METRICS_CONCAT_INNER(a, b) a##b
+#define AOC_METRICS_CONCAT(a, b) AOC_METRICS_CONCAT_INNER(a, b)
+
+#ifdef AOC_METRICS
+
+#define AOC_COUNT(name, amount)                                  \
+  do {                                                           \
+    static ::aoc::metrics::Counter& aoc_metrics_counter{         \
+        ::aoc::metrics::Registry::instance().counter(name)};     \
+    aoc_metrics_counter.add(static_cast<uint64_t>(amount));      \
+  } while (false)
+
+#define AOC_SCOPED_TIMER(name)                                             \
+  static ::aoc::metrics::Timer& AOC_METRICS_CONCAT(aoc_metrics_timer_,     \
+                                                   __LINE__){              \
+      ::aoc::metrics::Registry::instance().timer(name)};                   \
+  ::aoc::metrics::ScopedTimer AOC_METRICS_CONCAT(aoc_metrics_scope_,       \
+                                                 __LINE__) {               \
+    AOC_METRICS_CONCAT(aoc_metrics_timer_, __LINE__)                       \
+  }
+
+#define AOC_RATIO(name, numerator, denominator)                            \
+  do {                                                                     \
+    [[maybe_unused]] static bool aoc_metrics_ratio{                        \
+        ::aoc::metrics::Registry::instance().ratio(name, numerator,        \
+                                                   denominator)};          \
+  } while (false)
+
+#else
+
+#define AOC_COUNT(name, amount) \
+  do {                          \
+  } while (false)
+#define AOC_SCOPED_TIMER(name)
+#define AOC_RATIO(name, numerator, denominator) \
+  do {                                          \
+  } while (false)
+
+#endif
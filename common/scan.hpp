@@ -0,0 +1,131 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <string_view>
+#include <system_error>
+
+/*
+    Compile-time line pattern matcher
+
+    Replaces `std::sscanf` in the parse loops. The pattern is a template
+    argument where every "{}" marks a field, for example:
+
+        aoc::scan<"turn on {},{} through {},{}">(line, x_1, y_1, x_2, y_2)
+
+    The pattern is split into its literal segments at compile time, so a call
+    is a single left-to-right pass over the line that only compares literal
+    prefixes and converts fields in place:
+        - integral fields are parsed with `std::from_chars`
+        - `std::string_view` fields capture everything up to the first
+          character of the following literal (or the end of the line)
+
+    Nothing is allocated and nothing past the end of the `std::string_view`
+    is read. A call succeeds only when the whole line matches the pattern.
+*/
+
+namespace aoc {
+
+template <size_t N>
+struct FixedString {
+  char data[N]{};
+
+  constexpr FixedString(const char (&str)[N]) { std::copy_n(str, N, data); }
+
+  constexpr std::string_view view() const { return {data, N - 1}; }
+};
+
+namespace detail {
+
+template <FixedString Pattern>
+struct CompiledPattern {
+  static constexpr std::string_view pattern{Pattern.view()};
+
+  static constexpr size_t fields{[] {
+    size_t count{};
+    for (size_t pos{pattern.find("{}")}; pos != std::string_view::npos;
+         pos = pattern.find("{}", pos + 2)) {
+      ++count;
+    }
+    return count;
+  }()};
+
+  // literal text before, between and after the fields
+  static constexpr std::array<std::string_view, fields + 1> literals{[] {
+    std::array<std::string_view, fields + 1> result{};
+    size_t start{};
+    for (size_t i{}; i < fields; ++i) {
+      size_t pos{pattern.find("{}", start)};
+      result[i] = pattern.substr(start, pos - start);
+      start = pos + 2;
+    }
+    result[fields] = pattern.substr(start);
+    return result;
+  }()};
+
+  static constexpr bool fields_are_delimited{[] {
+    for (size_t i{1}; i < fields; ++i) {
+      if (literals[i].empty()) {
+        return false;
+      }
+    }
+    return true;
+  }()};
+};
+
+template <std::integral T>
+constexpr bool parse_field(std::string_view& line, T& out, std::string_view) {
+  auto [ptr, ec]{std::from_chars(line.data(), line.data() + line.size(), out)};
+  if (ec != std::errc{}) {
+    return false;
+  }
+  line.remove_prefix(static_cast<size_t>(ptr - line.data()));
+  return true;
+}
+
+constexpr bool parse_field(std::string_view& line, std::string_view& out,
+                           std::string_view next_literal) {
+  size_t end{next_literal.empty() ? line.size()
+                                  : line.find(next_literal.front())};
+  if (end == 0 || end == std::string_view::npos) {
+    return false;
+  }
+  out = line.substr(0, end);
+  line.remove_prefix(end);
+  return true;
+}
+
+constexpr bool consume(std::string_view& line, std::string_view literal) {
+  if (!line.starts_with(literal)) {
+    return false;
+  }
+  line.remove_prefix(literal.size());
+  return true;
+}
+
+}  // namespace detail
+
+template <FixedString Pattern, typename... Fields>
+constexpr bool scan(std::string_view line, Fields&... fields) {
+  using Compiled = detail::CompiledPattern<Pattern>;
+  static_assert(sizeof...(Fields) == Compiled::fields,
+                "number of arguments must match the number of {} fields");
+  static_assert(Compiled::fields_are_delimited,
+                "adjacent {} fields need a literal between them");
+
+  if (!detail::consume(line, Compiled::literals[0])) {
+    return false;
+  }
+
+  size_t i{};
+  bool matched{((++i, detail::parse_field(line, fields, Compiled::literals[i]) &&
+                          detail::consume(line, Compiled::literals[i])) &&
+                ...)};
+
+  return matched && line.empty();
+}
+
+}  // namespace aoc
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/*
+    Summary statistics for benchmark samples
+
+    Percentiles use the nearest-rank method on a sorted copy of the samples,
+    so every reported value is one that was actually measured.
+
+    `mann_whitney_greater` compares two sample sets for the benchmark's
+    regression gate, giving both a p-value and an effect size.
+*/
+
+namespace aoc::stats {
+
+struct Summary {
+  double min;
+  double median;
+  double p99;
+};
+
+inline double percentile(const std::vector<double>& sorted, double p) {
+  if (sorted.empty()) {
+    return 0.0;
+  }
+  size_t rank{static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()))};
+  return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+inline Summary summarize(std::vector<double> samples) {
+  std::sort(samples.begin(), samples.end());
+  return Summary{samples.empty() ? 0.0 : samples.front(),
+                 percentile(samples, 50.0), percentile(samples, 99.0)};
+}
+
+struct MannWhitney {
+  double p;
+  // the chance that a random `current` sample beats a random `baseline`
+  // one, ties counting half (Vargha-Delaney A): 0.5 means no effect
+  double effect;
+};
+
+// One-sided Mann-Whitney U test: the p-value for "`current` tends to be
+// larger than `baseline`", using the normal approximation with tie and
+// continuity corrections (reasonable from about 8 samples per side). Being
+// rank-based, a few outliers from a noisy machine do not sway it the way
+// they would a t-test on means. With many samples a tiny shift becomes
+// significant, so callers should also require a large enough `effect`.
+inline MannWhitney mann_whitney_greater(const std::vector<double>& baseline,
+                                        const std::vector<double>& current) {
+  double n_1{static_cast<double>(baseline.size())};
+  double n_2{static_cast<double>(current.size())};
+  if (baseline.empty() || current.empty()) {
+    return MannWhitney{1.0, 0.5};
+  }
+
+  std::vector<std::pair<double, bool /* from current */>> pooled{};
+  pooled.reserve(baseline.size() + current.size());
+  for (double sample : baseline) {
+    pooled.emplace_back(sample, false);
+  }
+  for (double sample : current) {
+    pooled.emplace_back(sample, true);
+  }
+  std::sort(pooled.begin(), pooled.end());
+
+  // ranks start at 1; tied samples share the mean of their ranks
+  double current_rank_sum{};
+  double tie_term{};
+  for (size_t i{}; i < pooled.size();) {
+    size_t j{i};
+    while (j < pooled.size() && pooled[j].first == pooled[i].first) {
+      ++j;
+    }
+    double ties{static_cast<double>(j - i)};
+    double rank{(i + 1 + j) / 2.0};
+    for (size_t k{i}; k < j; ++k) {
+      if (pooled[k].second) {
+        current_rank_sum += rank;
+      }
+    }
+    tie_term += ties * ties * ties - ties;
+    i = j;
+  }
+
+  double n{n_1 + n_2};
+  double u{current_rank_sum - n_2 * (n_2 + 1) / 2};
+  double mean{n_1 * n_2 / 2};
+  double variance{n_1 * n_2 / 12 * ((n + 1) - tie_term / (n * (n - 1)))};
+  double effect{u / (n_1 * n_2)};
+  if (variance <= 0.0) {
+    return MannWhitney{1.0, effect};  // every sample is identical
+  }
+
+  double z{(u - mean - 0.5) / std::sqrt(variance)};
+  return MannWhitney{0.5 * std::erfc(z / std::sqrt(2.0)), effect};
+}
+
+}  // namespace aoc::stats
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+/*
+    Streaming input reader
+
+    For single-pass solvers that keep O(1) state, reads a file (or stdin when
+    the path is "-") in fixed-size chunks through one reusable buffer instead
+    of loading the whole input, so arbitrarily large or piped inputs run in
+    constant memory.
+
+        for_each_chunk(path, fn)  -- fn(std::string_view chunk) per read
+        for_each_line(path, fn)   -- fn(std::string_view line) per '\n'-
+                                     terminated line, without the '\n'
+
+    `for_each_line` carries a line that crosses a chunk boundary over to the
+    front of the buffer before the next read; the buffer only grows if a
+    single line is longer than a whole chunk. Like the buffer-based parse
+    loops, a trailing '\n' does not produce a final empty line.
+*/
+
+namespace aoc {
+
+inline constexpr size_t DEFAULT_CHUNK_SIZE{1 << 20};
+
+class ChunkReader {
+ public:
+  explicit ChunkReader(const char* path) {
+    owns_fd_ = std::strcmp(path, "-") != 0;
+    fd_ = owns_fd_ ? ::open(path, O_RDONLY | O_CLOEXEC) : STDIN_FILENO;
+    if (fd_ < 0) {
+      throw std::runtime_error("could not open input file");
+    }
+    ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+  }
+
+  ~ChunkReader() {
+    if (owns_fd_) {
+      ::close(fd_);
+    }
+  }
+
+  ChunkReader(const ChunkReader&) = delete;
+  ChunkReader& operator=(const ChunkReader&) = delete;
+
+  // fills as much of [dest, dest + size) as one read returns; 0 at the end
+  size_t read(char* dest, size_t size) {
+    while (true) {
+      ssize_t n{::read(fd_, dest, size)};
+      if (n >= 0) {
+        return static_cast<size_t>(n);
+      }
+      if (errno != EINTR) {
+        throw std::runtime_error("could not read input file");
+      }
+    }
+  }
+
+ private:
+  int fd_{};
+  bool owns_fd_{};
+};
+
+template <typename F>
+void for_each_chunk(const char* path, F&& on_chunk,
+                    size_t chunk_size = DEFAULT_CHUNK_SIZE) {
+  ChunkReader reader{path};
+  std::vector<char> buffer(chunk_size);
+
+  while (size_t n{reader.read(buffer.data(), buffer.size())}) {
+    on_chunk(std::string_view{buffer.data(), n});
+  }
+}
+
+template <typename F>
+void for_each_line(const char* path, F&& on_line,
+                   size_t chunk_size = DEFAULT_CHUNK_SIZE) {
+  ChunkReader reader{path};
+  std::vector<char> buffer(chunk_size);
+  size_t carried{};  // bytes of an unfinished line at the front of buffer
+
+  while (true) {
+    if (carried == buffer.size()) {
+      buffer.resize(buffer.size() * 2);  // a single line outgrew the buffer
+    }
+
+    size_t n{reader.read(buffer.data() + carried, buffer.size() - carried)};
+    if (n == 0) {
+      break;
+    }
+
+    std::string_view data{buffer.data(), carried + n};
+
+    size_t pos{};
+    while (true) {
+      size_t end{data.find('\n', pos)};
+      if (end == std::string_view::npos) {
+        break;
+      }
+      on_line(data.substr(pos, end - pos));
+      pos = end + 1;
+    }
+
+    carried = data.size() - pos;
+    std::memmove(buffer.data(), buffer.data() + pos, carried);
+  }
+
+  if (carried > 0) {
+    on_line(std::string_view{buffer.data(), carried});
+  }
+}
+
+}  // namespace aoc
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*
+    Work-stealing thread pool
+
+    Every worker owns a task queue. Tasks submitted from outside the pool are
+    dealt round-robin across the queues; tasks submitted from inside a task go
+    to the submitting worker's own queue. A worker takes tasks from the front
+    of its own queue, so they run roughly in submission order, and when it runs
+    dry it steals from the back of the other queues. Long tasks therefore never
+    strand the short ones queued behind them: idle workers pull those away.
+*/
+
+namespace aoc {
+
+class ThreadPool {
+ public:
+  using Task = std::function<void()>;
+
+  explicit ThreadPool(size_t threads = std::thread::hardware_concurrency()) {
+    threads = std::max<size_t>(threads, 1);
+
+    queues_.reserve(threads);
+    for (size_t i{}; i < threads; ++i) {
+      queues_.push_back(std::make_unique<Queue>());
+    }
+
+    workers_.reserve(threads);
+    for (size_t i{}; i < threads; ++i) {
+      workers_.emplace_back([this, i] { run_worker(i); });
+    }
+  }
+
+  ~ThreadPool() {
+    {
+      std::lock_guard lock{mutex_};
+      stopping_ = true;
+    }
+    work_available_.notify_all();
+    workers_.clear();  // join before the queues and condition variables go
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  void submit(Task task) {
+    size_t index{current_pool_ == this
+                     ? current_worker_
+                     : next_queue_.fetch_add(1, std::memory_order_relaxed) %
+                           queues_.size()};
+
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    {
+      std::lock_guard lock{queues_[index]->mutex};
+      queues_[index]->tasks.push_back(std::move(task));
+    }
+    {
+      std::lock_guard lock{mutex_};
+      ++queued_;
+    }
+    work_available_.notify_one();
+  }
+
+  // blocks until every submitted task, including ones submitted by tasks,
+  // has finished
+  void wait() {
+    std::unique_lock lock{mutex_};
+    all_done_.wait(lock, [this] {
+      return pending_.load(std::memory_order_acquire) == 0;
+    });
+  }
+
+  size_t size() const { return workers_.size(); }
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  bool pop_own(size_t index, Task& task) {
+    Queue& queue{*queues_[index]};
+    std::lock_guard lock{queue.mutex};
+    if (queue.tasks.empty()) {
+      return false;
+    }
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    return true;
+  }
+
+  bool steal(size_t thief, Task& task) {
+    for (size_t offset{1}; offset < queues_.size(); ++offset) {
+      Queue& victim{*queues_[(thief + offset) % queues_.size()]};
+      std::lock_guard lock{victim.mutex};
+      if (!victim.tasks.empty()) {
+        task = std::move(victim.tasks.back());
+        victim.tasks.pop_back();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void run_worker(size_t index) {
+    current_pool_ = this;
+    current_worker_ = index;
+
+    while (true) {
+      Task task{};
+      if (pop_own(index, task) || steal(index, task)) {
+        {
+          std::lock_guard lock{mutex_};
+          --queued_;
+        }
+        task();
+
+        if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          std::lock_guard lock{mutex_};
+          all_done_.notify_all();
+        }
+        continue;
+      }
+
+      std::unique_lock lock{mutex_};
+      work_available_.wait(lock, [this] { return stopping_ || queued_ > 0; });
+      if (stopping_ && queued_ == 0) {
+        return;
+      }
+    }
+  }
+
+  static inline thread_local ThreadPool* current_pool_{};
+  static inline thread_local size_t current_worker_{};
+
+  std::vector<std::unique_ptr<Queue>> queues_{};
+  std::vector<std::jthread> workers_{};
+
+  std::mutex mutex_{};
+  std::condition_variable work_available_{};
+  std::condition_variable all_done_{};
+  size_t queued_{};  // guarded by mutex_
+  bool stopping_{};  // guarded by mutex_
+  std::atomic<size_t> pending_{};
+  std::atomic<size_t> next_queue_{};
+};
+
+}  // namespace aoc